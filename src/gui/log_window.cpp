@@ -16,11 +16,11 @@ void update_logtext(GuiState& state) {
     int i = 0;
     auto endIt = state.game.getProgress().end();
     for (auto move = state.game.getProgress().begin(); move != endIt; ++move) {
-        std::shared_ptr<Move> firstMove = (*move)->moveToNext;
+        const Move* firstMove = move->moveToNext;
         if (!firstMove) continue;
         ++move;
         if (move != endIt) {
-            std::shared_ptr<Move> secondMove = (*move)->moveToNext;
+            const Move* secondMove = move->moveToNext;
             if (secondMove) {
                 state.log_text += fmt::format("{}: {} {}", ++i, *firstMove, *secondMove);
                 if (i % 4 == 0)
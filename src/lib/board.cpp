@@ -1,7 +1,6 @@
 #include "board.h"
 
 #include <base/improve_containers.h>
-#include <base/strings.h>
 
 #include <cassert>
 #include <cstdlib>
@@ -10,6 +9,7 @@
 
 #include "board_debug.h"
 #include "common_debug.h"
+#include "fen.h"
 #include "move.h"
 #include "types.h"
 
@@ -22,166 +22,20 @@ Board::Board()
       _fullMoves(0),
       _legality(Legality::UNDETERMINED) {}
 
-ChessField getChessFieldFromString(std::string str) {
-    char filechar = str[0];
-    char rankchar = str[1];
-
-    ChessFile file = A;
-    switch (filechar) {
-        case 'a':
-        case 'A':
-            file = A;
-            break;
-        case 'b':
-        case 'B':
-            file = B;
-            break;
-        case 'c':
-        case 'C':
-            file = C;
-            break;
-        case 'd':
-        case 'D':
-            file = D;
-            break;
-        case 'e':
-        case 'E':
-            file = E;
-            break;
-        case 'f':
-        case 'F':
-            file = F;
-            break;
-        case 'g':
-        case 'G':
-            file = G;
-            break;
-        case 'h':
-        case 'H':
-            file = H;
-            break;
-    }
-
-    return ChessField{file, rankchar - 0x30};
-}
-
-Board::Board(const std::string& fen)
-    : _board(),
-      _canCastle(0x00),
-      _enpassantTarget(),
-      _whosTurn(Color::WHITE),
-      _halfmoveClock(0),
-      _fullMoves(0),
-      _legality(Legality::UNDETERMINED) {
-    std::vector<std::string> fields = base::split(fen, ' ', 6);
-    std::vector<std::string> ranks = base::split(fields[0], '/', 8);
-
-    int rank = 8;
-    for (auto rankStr : ranks) {
-        int file = A;
-
-        for (char c : rankStr) {
-            if (c >= 0x31 && c <= 0x38) {
-                int skip = (c - 0x30);
-                file += skip;
-                continue;
-            }
-            ChessPiece cp = getChessPieceFromDebugChar(c);
-            setField({file, rank}, cp);
-            ++file;
-        }
-        --rank;
-    }
-
-    if (fields.size() > 1) {
-        Color turn = (fields[1] == "w" ? Color::WHITE : Color::BLACK);
-        setTurn(turn);
-
-        if (fields[2].find('Q') != std::string::npos) setCastling(Castling::WHITE_LONG);
-        if (fields[2].find('K') != std::string::npos) setCastling(Castling::WHITE_SHORT);
-        if (fields[2].find('q') != std::string::npos) setCastling(Castling::BLACK_LONG);
-        if (fields[2].find('k') != std::string::npos) setCastling(Castling::BLACK_SHORT);
-
-        if (fields[3] != "-") {
-            setEnPassantTarget(getChessFieldFromString(fields[3]));
-        }
-    }
-
-    if (fields.size() > 5) {
-        _halfmoveClock = std::stoi(fields[4]);
-        _fullMoves = std::stoi(fields[5]);
-    }
+Board::Board(std::string_view fen) : Board() {
+    [[maybe_unused]] FenResult result = Fen::parse(fen, *this);
+    assert(result);
 }
 
 std::string Board::getFENString(bool includeMoveCount) const {
-    std::stringstream ss;
-    int rank = 8;
-    int file = A;
-    int empty = 0;
-    bool first = true;
-    for (; rank > 0; --rank) {
-        if (!first) ss << '/';
-        first = false;
-        for (file = A; file <= H; ++file) {
-            auto piece = getPieceOnField(file, rank);
-            if (piece) {
-                if (empty > 0) {
-                    ss << empty;
-                    empty = 0;
-                }
-                ss << getDebugCharForPiece(*piece, true);
-            } else {
-                ++empty;
-            }
-        }
-        if (empty > 0) {
-            ss << empty;
-            empty = 0;
-        }
-    }
-    ss << ' ';
-    ss << (whosTurnIsIt() == Color::WHITE ? 'w' : 'b');
-    ss << ' ';
-    bool castle = false;
-    if (canCastle(Castling::WHITE_LONG)) {
-        ss << 'Q';
-        castle = true;
-    }
-    if (canCastle(Castling::WHITE_SHORT)) {
-        ss << 'K';
-        castle = true;
-    }
-    if (canCastle(Castling::BLACK_LONG)) {
-        ss << 'q';
-        castle = true;
-    }
-    if (canCastle(Castling::BLACK_SHORT)) {
-        ss << 'k';
-        castle = true;
-    }
-    if (!castle) {
-        ss << '-';
-    }
-
-    ss << ' ';
-
-    if (hasEnPassantTarget()) {
-        ss << getStringFromChessField(*getEnPassantTarget());
-    } else {
-        ss << '-';
-    }
-
-    if (includeMoveCount) {
-        ss << ' ' << _halfmoveClock << ' ' << _fullMoves;
-    }
-
-    return ss.str();
+    Fen::Buffer buffer;
+    return std::string(Fen::write(*this, buffer, includeMoveCount));
 }
 
 Board::~Board() {}
 
 void Board::setField(ChessFile file, ChessRank rank, ChessPiece chessPiece) {
-    _board[BoardHelper::fieldToIndex({file, rank})] = chessPiece;
+    _board[Square(file, rank).index()] = chessPiece;
     _legality = Legality::UNDETERMINED;
 }
 
@@ -190,31 +44,23 @@ void Board::setField(ChessField field, ChessPiece chessPiece) {
 }
 
 void Board::clearField(ChessFile file, ChessRank rank) {
-    _board[BoardHelper::fieldToIndex({file, rank})].reset();
+    _board[Square(file, rank).index()] = PieceCode();
     _legality = Legality::UNDETERMINED;
 }
 
 void Board::clearField(ChessField field) { clearField(std::get<ChessFileIdx>(field), std::get<ChessRankIdx>(field)); }
 
 std::optional<ChessPiece> Board::getPieceOnField(ChessFile file, ChessRank rank) const {
-    return _board[BoardHelper::fieldToIndex({file, rank})];
+    return _board[Square(file, rank).index()].toOptional();
 }
 
 std::optional<ChessPiece> Board::getPieceOnField(ChessField field) const {
     return getPieceOnField(std::get<ChessFileIdx>(field), std::get<ChessRankIdx>(field));
 }
 
-int BoardHelper::fieldToIndex(ChessField field) {
-    assert(std::get<ChessRankIdx>(field) > 0 && std::get<ChessRankIdx>(field) < 9 && std::get<ChessFileIdx>(field) > 0 &&
-           std::get<ChessFileIdx>(field) < 9);
-    return (std::get<ChessRankIdx>(field) - 1) * 8 + std::get<ChessFileIdx>(field) - 1;
-}
+int BoardHelper::fieldToIndex(ChessField field) { return Square(field).index(); }
 
-ChessField BoardHelper::indexToField(int index) {
-    ChessFile file = (index % 8);
-    ChessRank rank = index / 8;
-    return {file + 1, rank + 1};
-}
+ChessField BoardHelper::indexToField(int index) { return Square::fromIndex(index); }
 
 bool BoardHelper::isInBounds(ChessField field) {
     auto rank = std::get<ChessRankIdx>(field);
@@ -235,8 +81,8 @@ std::optional<ChessField> BoardHelper::determineEnPassantCaptureTarget(ChessFiel
 std::vector<ChessPieceOnField> Board::getAllPieces(Color color) const {
     std::vector<ChessPieceOnField> pieces;
     for (int i = 0; i < 64; ++i) {
-        if (_board[i].has_value() && std::get<ColorIdx>(_board[i].value()) == color) {
-            pieces.push_back({_board[i].value(), BoardHelper::indexToField(i)});
+        if (_board[i] && _board[i].color() == color) {
+            pieces.push_back({_board[i], BoardHelper::indexToField(i)});
         }
     }
     return pieces;
@@ -276,7 +122,7 @@ void Board::setTurn(Color color) { _whosTurn = color; }
 
 std::optional<ChessField> Board::findFirstPiece(const std::function<bool(ChessPiece)>& predicate) const {
     for (int i = 0; i < 64; ++i) {
-        if (_board[i].has_value() && predicate(_board[i].value())) {
+        if (_board[i] && predicate(_board[i])) {
             return BoardHelper::indexToField(i);
         }
     }
@@ -284,7 +130,7 @@ std::optional<ChessField> Board::findFirstPiece(const std::function<bool(ChessPi
 }
 
 int Board::countAllPieces(const std::function<bool(ChessPiece)>& predicate) const {
-    return base::count_if(_board, [&predicate](auto& piece) { return piece && predicate(*piece); });
+    return base::count_if(_board, [&predicate](PieceCode piece) { return piece && predicate(piece); });
 }
 
 void Board::setLegality(Legality legality) { _legality = legality; }
@@ -5,12 +5,16 @@
 #include <cstdint>
 #include <functional>
 #include <optional>
+#include <string>
+#include <string_view>
 #include <vector>
 
 #include "board_factory.h"
 #include "rules.h"
 #include "types.h"
 
+class Fen;
+struct PackedPosition;
 class Move;
 
 class BoardHelper {
@@ -56,9 +60,10 @@ class Board {
     Board(const Board& orig) = default;
 
     /**
-     * @brief Construct a new chess-board object from FEN String
+     * @brief Construct a new chess-board object from FEN String. The string must be valid, use Fen::parse
+     *        to check strings of unknown origin.
      */
-    Board(const std::string& fen);
+    Board(std::string_view fen);
 
     /**
      * @brief Destroy the chess-board object
@@ -142,6 +147,13 @@ class Board {
      */
     std::optional<ChessPiece> getPieceOnField(ChessField field) const;
 
+    /**
+     * @brief Return the compact code of the piece on a square, empty if there is none
+     *
+     * Cheaper than getPieceOnField as it skips the conversion into tuples. Meant for hot paths.
+     */
+    PieceCode getPieceCode(Square square) const { return _board[square.index()]; }
+
     /**
      * @brief Get the All Pieces of one color currently on the board
      *
@@ -187,7 +199,7 @@ class Board {
     void setLegality(Legality legality);
     Legality getLegality() const;
 
-    std::array<std::optional<ChessPiece>, 64> _board;
+    std::array<PieceCode, 64> _board;
     base::flag_mask<Castling> _canCastle;
     std::optional<ChessField> _enpassantTarget;
     Color _whosTurn;
@@ -197,4 +209,6 @@ class Board {
     Legality _legality;
 
     friend BoardFactory;
+    friend Fen;
+    friend PackedPosition;
 };
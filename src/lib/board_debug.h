@@ -30,12 +30,7 @@ inline std::string getStringFromPiece(const Piece &piece) {
 }
 
 inline std::string getStringFromChessField(const ChessField &cf) {
-    std::stringstream ss;
-
-    ss << (char)(std::get<ChessFileIdx>(cf) - (char)1 + 'a');
-    ss << (char)(std::get<ChessRankIdx>(cf) + '0');
-
-    return ss.str();
+    return {(char)(std::get<ChessFileIdx>(cf) - (char)1 + 'a'), (char)(std::get<ChessRankIdx>(cf) + '0')};
 }
 
 /**
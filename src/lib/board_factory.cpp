@@ -17,5 +17,5 @@ Board BoardFactory::createStandardBoard() {
 
 //           8/5k2/3p4/1p1Pp2p/pP2Pp1P/P4P1K/8/8 b - - 99 50
 // or        8/5k2/3p4/1p1Pp2p/pP2Pp1P/P4P1K/8/8
-// currently this assumes a valid FEN string and will fail in case of an invalid one
-Board BoardFactory::createBoardFromFEN(std::string fen) { return Board{fen}; }
+// this assumes a valid FEN string and will fail in case of an invalid one
+Board BoardFactory::createBoardFromFEN(std::string_view fen) { return Board{fen}; }
@@ -1,5 +1,5 @@
 #pragma once
-#include <string>
+#include <string_view>
 
 class Board;
 
@@ -32,8 +32,9 @@ class BoardFactory {
      * @brief Creates a chess-board from FEN String
      *
      * Sets Chess Board from FEN String https://www.chess.com/terms/fen-chess
+     * The string must be valid, use Fen::parse for strings of unknown origin.
      *
      * @return Created chess-board
      */
-    static Board createBoardFromFEN(std::string fen);
+    static Board createBoardFromFEN(std::string_view fen);
 };
\ No newline at end of file
@@ -0,0 +1,177 @@
+#include "book_builder.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <thread>
+
+#include "board_factory.h"
+#include "opening_book.h"
+#include "rules.h"
+#include "zobrist.h"
+
+static unsigned resolveThreadCount(unsigned threads) { return threads > 0 ? threads : std::max(1u, std::thread::hardware_concurrency()); }
+
+BookBuilder::BookBuilder(const BookBuilderOptions& options) : _options(options) {}
+
+void BookBuilder::count(uint64_t key, uint16_t move, uint32_t points) {
+    std::vector<MoveStatistics>& moves = _shards[key >> (64 - ShardBits)][key];
+    auto it = std::find_if(moves.begin(), moves.end(), [move](const MoveStatistics& stats) { return stats.move == move; });
+    if (it == moves.end()) {
+        moves.push_back({move, 1, points});
+    } else {
+        ++it->games;
+        it->points += points;
+    }
+}
+
+bool BookBuilder::addGame(const PgnGame& game) {
+    uint32_t whitePoints = 0;
+    if (game.result == "1-0")
+        whitePoints = 2;
+    else if (game.result == "1/2-1/2")
+        whitePoints = 1;
+    else if (game.result != "0-1")
+        return false;
+    if (game.getTag("FEN")) return false;
+
+    Board board = BoardFactory::createStandardBoard();
+    int maxPly = std::min<int>(_options.maxPly, game.moves.size());
+    for (int ply = 0; ply < maxPly; ++ply) {
+        const Move& move = game.moves[ply];
+        uint32_t points = (board.whosTurnIsIt() == Color::WHITE ? whitePoints : 2 - whitePoints);
+        count(Zobrist::hash(board), PolyglotBook::encodeMove(move), points);
+        ChessRules::applyMove(board, move);
+    }
+    return true;
+}
+
+size_t BookBuilder::addPgn(PgnReader& reader) {
+    size_t games = 0;
+    for (const PgnGame& game : reader) {
+        if (addGame(game)) ++games;
+    }
+    return games;
+}
+
+size_t BookBuilder::getPositionCount() const {
+    size_t positions = 0;
+    for (const PositionMap& shard : _shards) positions += shard.size();
+    return positions;
+}
+
+std::vector<BookRecord> BookBuilder::getRecords() const { return merge({this}, 1); }
+
+std::vector<BookRecord> BookBuilder::merge(const std::vector<const BookBuilder*>& builders, unsigned threads) {
+    if (builders.empty()) return {};
+    uint32_t minGames = builders.front()->_options.minGames;
+
+    // Every shard covers a contiguous key range, so sorted shards concatenate to a sorted book
+    std::array<std::vector<BookRecord>, ShardCount> shardRecords;
+    std::atomic<size_t> nextShard = 0;
+    auto mergeShards = [&]() {
+        for (size_t shard = nextShard++; shard < ShardCount; shard = nextShard++) {
+            PositionMap merged;
+            for (const BookBuilder* builder : builders) {
+                for (const auto& [key, moves] : builder->_shards[shard]) {
+                    std::vector<MoveStatistics>& mergedMoves = merged[key];
+                    for (const MoveStatistics& stats : moves) {
+                        auto it = std::find_if(mergedMoves.begin(), mergedMoves.end(),
+                                               [&stats](const MoveStatistics& other) { return other.move == stats.move; });
+                        if (it == mergedMoves.end()) {
+                            mergedMoves.push_back(stats);
+                        } else {
+                            it->games += stats.games;
+                            it->points += stats.points;
+                        }
+                    }
+                }
+            }
+
+            std::vector<BookRecord>& records = shardRecords[shard];
+            for (const auto& [key, moves] : merged) {
+                uint32_t maxPoints = 0;
+                for (const MoveStatistics& stats : moves) {
+                    if (stats.games >= minGames) maxPoints = std::max(maxPoints, stats.points);
+                }
+                // Weights are 16 bit, so scale down positions with too many games
+                for (const MoveStatistics& stats : moves) {
+                    if (stats.games < minGames || stats.points == 0) continue;
+                    uint64_t weight = stats.points;
+                    if (maxPoints > UINT16_MAX) weight = std::max<uint64_t>(1, weight * UINT16_MAX / maxPoints);
+                    records.push_back({key, stats.move, static_cast<uint16_t>(weight)});
+                }
+            }
+            std::sort(records.begin(), records.end(), [](const BookRecord& a, const BookRecord& b) {
+                return a.key != b.key ? a.key < b.key : (a.weight != b.weight ? a.weight > b.weight : a.move < b.move);
+            });
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned i = 1; i < std::min<size_t>(resolveThreadCount(threads), ShardCount); ++i) workers.emplace_back(mergeShards);
+    mergeShards();
+    for (std::thread& worker : workers) worker.join();
+
+    std::vector<BookRecord> records;
+    size_t total = 0;
+    for (const auto& shard : shardRecords) total += shard.size();
+    records.reserve(total);
+    for (const auto& shard : shardRecords) records.insert(records.end(), shard.begin(), shard.end());
+    return records;
+}
+
+std::vector<BookRecord> BookBuilder::buildFromFiles(const std::vector<std::string>& paths, const BookBuilderOptions& options,
+                                                    size_t* games) {
+    size_t threadCount = std::min<size_t>(resolveThreadCount(options.threads), std::max<size_t>(1, paths.size()));
+    std::vector<std::unique_ptr<BookBuilder>> builders;
+    for (size_t i = 0; i < threadCount; ++i) builders.push_back(std::make_unique<BookBuilder>(options));
+
+    std::atomic<size_t> nextFile = 0;
+    std::atomic<size_t> gameCount = 0;
+    std::atomic<bool> failed = false;
+    auto parseFiles = [&](BookBuilder& builder) {
+        for (size_t file = nextFile++; file < paths.size(); file = nextFile++) {
+            PgnReader reader;
+            if (!reader.open(paths[file])) {
+                failed = true;
+                return;
+            }
+            reader.setResolvePlies(options.maxPly);
+            gameCount += builder.addPgn(reader);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < threadCount; ++i) workers.emplace_back(parseFiles, std::ref(*builders[i]));
+    parseFiles(*builders[0]);
+    for (std::thread& worker : workers) worker.join();
+
+    if (games) *games = gameCount;
+    if (failed) return {};
+
+    std::vector<const BookBuilder*> parts;
+    for (const auto& builder : builders) parts.push_back(builder.get());
+    return merge(parts, options.threads);
+}
+
+static void writeBigEndian(std::vector<char>& buffer, uint64_t value, int bytes) {
+    for (int i = bytes - 1; i >= 0; --i) buffer.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+}
+
+bool BookBuilder::write(const std::string& path, const std::vector<BookRecord>& records) {
+    std::ofstream output(path, std::ios::binary | std::ios::trunc);
+    if (!output) return false;
+
+    std::vector<char> buffer;
+    buffer.reserve(PolyglotBook::EntrySize * records.size());
+    for (const BookRecord& record : records) {
+        writeBigEndian(buffer, record.key, 8);
+        writeBigEndian(buffer, record.move, 2);
+        writeBigEndian(buffer, record.weight, 2);
+        writeBigEndian(buffer, 0, 4);  // learn
+    }
+    output.write(buffer.data(), buffer.size());
+    return static_cast<bool>(output);
+}
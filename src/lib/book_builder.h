@@ -0,0 +1,107 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/helpers.h"
+#include "pgn.h"
+
+/**
+ * @brief One record of a Polyglot book before it is written to disk
+ */
+struct BookRecord {
+    uint64_t key;
+    uint16_t move;
+    uint16_t weight;
+
+    bool operator==(const BookRecord& other) const = default;
+};
+
+struct BookBuilderOptions {
+    int maxPly = 20;        ///< Only the first plies of every game end up in the book
+    uint32_t minGames = 1;  ///< Moves played in fewer games are dropped
+    unsigned threads = 0;   ///< Worker threads, 0 means one per hardware thread
+};
+
+/**
+ * @brief Aggregates the moves played in PGN games into Polyglot book records
+ *
+ * Every game is replayed up to the configured ply. Per position (keyed by Zobrist::hash) and move the
+ * number of games and the points scored by the moving side (2 for a win, 1 for a draw) are counted.
+ * The points become the weight of the move in the book.
+ *
+ * A builder is not thread safe. To build a book in parallel use one builder per thread and merge them;
+ * the statistics are kept in shards by the upper key bits so the merge is parallel as well.
+ */
+class BookBuilder : base::NONCOPYABLE {
+   public:
+    explicit BookBuilder(const BookBuilderOptions& options = {});
+
+    /**
+     * @brief Replay the resolved moves of a game and count them
+     *
+     * Games without a decisive or drawn result and games starting from a custom position are skipped.
+     * The reader only needs to resolve the first maxPly plies (see PgnReader::setResolvePlies).
+     *
+     * @return bool - Was the game counted?
+     */
+    bool addGame(const PgnGame& game);
+
+    /**
+     * @brief Add all remaining games of a PGN reader
+     *
+     * @return size_t Number of counted games
+     */
+    size_t addPgn(PgnReader& reader);
+
+    size_t getPositionCount() const;
+
+    /**
+     * @brief Sorted records of this builder, ready to be written
+     */
+    std::vector<BookRecord> getRecords() const;
+
+    /**
+     * @brief Merge the statistics of several builders into sorted records
+     *
+     * @param builders  Builders created with the same options
+     * @param threads   Number of threads merging shards, 0 means one per hardware thread
+     */
+    static std::vector<BookRecord> merge(const std::vector<const BookBuilder*>& builders, unsigned threads = 0);
+
+    /**
+     * @brief Build the records from PGN files, parsing and replaying the files in parallel
+     *
+     * @param paths    PGN files to read
+     * @param options  Builder options, including the number of threads
+     * @param games    Receives the number of counted games (optional)
+     * @return std::vector<BookRecord> Sorted records, empty if a file can not be read
+     */
+    static std::vector<BookRecord> buildFromFiles(const std::vector<std::string>& paths, const BookBuilderOptions& options,
+                                                  size_t* games = nullptr);
+
+    /**
+     * @brief Write records in Polyglot .bin format
+     *
+     * @return bool - Was the file written?
+     */
+    static bool write(const std::string& path, const std::vector<BookRecord>& records);
+
+   private:
+    struct MoveStatistics {
+        uint16_t move;
+        uint32_t games;
+        uint32_t points;
+    };
+    using PositionMap = std::unordered_map<uint64_t, std::vector<MoveStatistics>>;
+
+    static constexpr int ShardBits = 6;
+    static constexpr size_t ShardCount = size_t{1} << ShardBits;
+
+    void count(uint64_t key, uint16_t move, uint32_t points);
+
+    BookBuilderOptions _options;
+    std::array<PositionMap, ShardCount> _shards;
+};
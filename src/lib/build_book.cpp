@@ -0,0 +1,52 @@
+#include <base/argparser.h>
+#include <base/strings.h>
+#include <fmt/core.h>
+
+#include <iostream>
+
+#include "bench.h"
+#include "book_builder.h"
+
+using base::argparser;
+
+base::BenchmarkStatistics CHESS_BENCH;
+
+int main(int argc, char** argv) {
+    argparser parser{"build_book"};
+
+    parser.add_flag("help").short_option('h').description("Print help");
+    parser.add_option<std::string>("pgn").short_option('p').description("Comma separated list of PGN files to read").default_value("");
+    parser.add_option<std::string>("output").short_option('o').description("Polyglot book file to write").default_value("book.bin");
+    parser.add_option<int>("ply").short_option('d').description("Number of plies per game to put into the book").default_value(20);
+    parser.add_option<int>("min-games").short_option('m').description("Drop moves played in fewer games").default_value(1);
+    parser.add_option<int>("threads").short_option('t').description("Number of threads, 0 for one per core").default_value(0);
+
+    auto options = parser.parse(argc, argv);
+
+    if (options.is_flag_set("help") || options.get<std::string>("pgn").empty()) {
+        parser.print_help(std::cout);
+        return 0;
+    }
+
+    BookBuilderOptions builderOptions;
+    builderOptions.maxPly = options.get<int>("ply");
+    builderOptions.minGames = std::max(1, options.get<int>("min-games"));
+    builderOptions.threads = std::max(0, options.get<int>("threads"));
+
+    std::vector<std::string> paths = base::split(options.get<std::string>("pgn"), ',');
+    size_t games = 0;
+    std::vector<BookRecord> records = BookBuilder::buildFromFiles(paths, builderOptions, &games);
+    if (records.empty()) {
+        fmt::print(stderr, "No book entries created from {} games\n", games);
+        return 1;
+    }
+
+    const std::string& output = options.get<std::string>("output");
+    if (!BookBuilder::write(output, records)) {
+        fmt::print(stderr, "Could not write {}\n", output);
+        return 1;
+    }
+    fmt::print("Wrote {} entries from {} games to {}\n", records.size(), games, output);
+
+    return 0;
+}
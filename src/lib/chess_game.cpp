@@ -2,6 +2,7 @@
 
 #include <base/improve_containers.h>
 
+#include <cassert>
 #include <iostream>
 #include <memory>
 #include <optional>
@@ -9,13 +10,18 @@
 
 #include "board_debug.h"
 #include "board_factory.h"
+#include "fen.h"
 #include "fmt/core.h"
 #include "move_debug.h"
+#include "pgn.h"
 #include "rules.h"
 #include "types.h"
+#include "zobrist.h"
 
 ChessGame::ChessGame(ChessPlayer& white, ChessPlayer& black)
-    : _board(BoardFactory::createStandardBoard()), _white(white), _black(black), _progress(_board, {}), _state(State::IDLE) {}
+    : _board(BoardFactory::createStandardBoard()), _white(white), _black(black), _progress(_board, {}), _state(State::IDLE) {
+    _repetitions.push(_board);
+}
 
 ChessPlayer& ChessGame::getWhite() { return _white; }
 ChessPlayer& ChessGame::getBlack() { return _black; }
@@ -23,21 +29,61 @@ ChessPlayer& ChessGame::getMovingPlayer() { return (_board.whosTurnIsIt() == Col
 
 ChessGame::State ChessGame::getState() const { return _state; }
 
-void ChessGame::startSyncronousGame(bool fullOutput) {
+static GameResult resultOf(const Board& board, GameStatus status, bool repetition) {
+    if (status == GameStatus::CHECK_MATE) return (board.whosTurnIsIt() == Color::WHITE ? GameResult::BLACK_WINS : GameResult::WHITE_WINS);
+    if (status != GameStatus::ONGOING || repetition) return GameResult::DRAW;
+    return GameResult::UNDECIDED;
+}
+
+GameResult ChessGame::getResult() const {
+    return resultOf(_board, ChessRules::evaluateStatus(_board), _repetitions.isThreefoldRepetition());
+}
+
+PlayoutResult ChessGame::playout(Board board, ChessPlayer& white, ChessPlayer& black, bool withHash, uint32_t maxPlies) {
+    PlayoutResult playout;
+    RepetitionHistory repetitions;
+    repetitions.push(board);
+    std::vector<Move> validMoves;
+    GameStatus status = ChessRules::evaluateStatus(board, validMoves);
+
+    while (status == GameStatus::ONGOING && !repetitions.isThreefoldRepetition()) {
+        // The cap only applies to games that are still running, a mate on the last ply is still a mate
+        if (maxPlies != 0 && playout.plies == maxPlies) {
+            if (withHash) playout.hash = Zobrist::hash(board);
+            return playout;
+        }
+        ChessPlayer& player = (board.whosTurnIsIt() == Color::WHITE ? white : black);
+        assert(player.useGetMove());
+        [[maybe_unused]] bool applied = ChessRules::applyMove(board, player.getMove(board, validMoves));
+        assert(applied);
+        ++playout.plies;
+        repetitions.push(board);
+        status = ChessRules::evaluateStatus(board, validMoves);
+    }
+
+    playout.result = resultOf(board, status, repetitions.isThreefoldRepetition());
+    if (withHash) playout.hash = Zobrist::hash(board);
+    return playout;
+}
+
+void ChessGame::startSyncronousGame(bool fullOutput, bool withResult) {
     if (_state != State::IDLE) {
         fmt::print("ChessGame state is not IDLE. Start a new game instead.\n");
     }
     _state = State::RUNNING;
     ChessPlayer* currentPlayer = &_white;
+    Fen::Buffer fenBuffer;
+
+    std::vector<Move> validMoves;
+    GameStatus status = ChessRules::evaluateStatus(_board, validMoves);
 
     if (fullOutput) fmt::print("ChessGame between {} (white) and {} (black)\n", _white.getName(), _black.getName());
-    while (!ChessRules::isGameOver(_board)) {
+    while (status == GameStatus::ONGOING && !_repetitions.isThreefoldRepetition()) {
         currentPlayer = (_board.whosTurnIsIt() == Color::WHITE ? &_white : &_black);
 
-        if (fullOutput) fmt::print("\n{:b}\n{}\n", _board, _board.getFENString(true));
+        if (fullOutput) fmt::print("\n{:b}\n{}\n", _board, Fen::write(_board, fenBuffer, true));
         if (fullOutput) fmt::print("It is {}'s turn\n", currentPlayer->getName());
 
-        std::vector<Move> validMoves = ChessRules::getAllValidMoves(_board, false);
         if (currentPlayer->useGetMove() == false) {
             fmt::print("Player {} does not support getMove() and no other way of input supported by this client.",
                        currentPlayer->getName());
@@ -47,39 +93,42 @@ void ChessGame::startSyncronousGame(bool fullOutput) {
         if (fullOutput) fmt::print("{} plays {}\n", currentPlayer->getName(), move);
 
         // fmt::print("{} - {}\n", _board.getFENString(), move);
-        assert(ChessRules::applyMove(_board, move, true));
+        [[maybe_unused]] bool applied = ChessRules::applyMove(_board, move, true);
+        assert(applied);
         _progress.addMove(move, _board, {});
+        _repetitions.push(_board);
+        status = ChessRules::evaluateStatus(_board, validMoves);
     }
 
     _state = State::FINISHED;
 
     if (fullOutput) {
-        int stateCtr = 0;
-        for (auto state : _progress) {
-            if (state == nullptr) {
-                fmt::print("Should NOT have happen!");
-                break;
-            }
-            if (state->moveToNext == nullptr) break;
-            if (stateCtr % 10 == 0) fmt::print("\n");
-            if (stateCtr % 2 == 0) fmt::print("{}. ", (stateCtr / 2) + 1);
-            fmt::print("{} ", *(state->moveToNext));
-            ++stateCtr;
-        }
-        fmt::print("\n");
+        GameResult result = resultOf(_board, status, _repetitions.isThreefoldRepetition());
+        PgnWriter writer;
+        writer.writeGame(_progress, PgnGameInfo{.white = _white.getName(),
+                                                .black = _black.getName(),
+                                                .result = std::string(PgnWriter::getResult(result))});
+        fmt::print("\n{}", writer.getText());
     }
+    if (withResult) printResult();
+}
 
-    fmt::print("{}\n", _board.getFENString(true));
+void ChessGame::printResult() const {
+    Fen::Buffer fenBuffer;
+    fmt::print("{}\n", Fen::write(_board, fenBuffer, true));
 
-    if (ChessRules::isCheckMate(_board)) {
-        ChessPlayer& winner = *currentPlayer;
-        ChessPlayer& loser = _board.whosTurnIsIt() == Color::WHITE ? _white : _black;
+    GameStatus status = ChessRules::evaluateStatus(_board);
+    if (status == GameStatus::CHECK_MATE) {
+        const ChessPlayer& loser = (_board.whosTurnIsIt() == Color::WHITE ? _white : _black);
+        const ChessPlayer& winner = (_board.whosTurnIsIt() == Color::WHITE ? _black : _white);
 
         fmt::print("{} is check-mate {} won\n", loser.getName(), winner.getName());
-    } else if (ChessRules::isStaleMate(_board)) {
+    } else if (status == GameStatus::STALE_MATE) {
         fmt::print("Game ends in a tie due to stale-mate \n");
-    } else if (_board.getHalfMoveClock() > 50) {
+    } else if (status == GameStatus::FIFTY_MOVE_RULE) {
         fmt::print("Game ends in a tie due to 50 move rule\n");
+    } else if (_repetitions.isThreefoldRepetition()) {
+        fmt::print("Game ends in a tie due to threefold repetition\n");
     }
 }
 
@@ -99,9 +148,11 @@ bool ChessGame::doAsyncMove(Color color, Move move) {
     if (base::find(validMoves, move) == validMoves.end()) {
         return false;
     }
-    assert(ChessRules::applyMove(_board, move, true));
+    [[maybe_unused]] bool applied = ChessRules::applyMove(_board, move, true);
+    assert(applied);
     _progress.addMove(move, _board, {});
-    if (ChessRules::isGameOver(_board)) {
+    _repetitions.push(_board);
+    if (ChessRules::evaluateStatus(_board) != GameStatus::ONGOING || _repetitions.isThreefoldRepetition()) {
         _state = State::FINISHED;
     }
     return true;
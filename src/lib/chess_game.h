@@ -1,22 +1,41 @@
 #pragma once
+#include <cstdint>
 #include <optional>
 
 #include "base/helpers.h"
 #include "board.h"
 #include "chess_player.h"
 #include "game.h"
+#include "game_tree.h"
 #include "move.h"
+#include "repetition_history.h"
 
 struct ExtraStateData {};
 
 using ChessGameProgress = Game<Board, Move, ExtraStateData>;
+using ChessGameTree = GameTree<Board, Move, ExtraStateData>;
+
+enum class GameResult { UNDECIDED, WHITE_WINS, BLACK_WINS, DRAW };
+
+struct PlayoutResult {
+    GameResult result = GameResult::UNDECIDED;
+    uint32_t plies = 0;
+    std::optional<uint64_t> hash = std::nullopt;  ///< Zobrist hash of the final position, if requested
+};
 
 class ChessGame : base::NONCOPYABLE {
    public:
     ChessGame() = delete;
     ChessGame(ChessPlayer& white, ChessPlayer& black);
 
-    void startSyncronousGame(bool fullOutput = true);
+    /**
+     * @brief Plays the game to its end
+     *
+     * @param fullOutput  Print every position and move, and the game as PGN at the end
+     * @param withResult  Print the final position and how the game ended, see printResult()
+     */
+    void startSyncronousGame(bool fullOutput = true, bool withResult = true);
+    void printResult() const;
 
     void startAsyncronousGame();
     bool doAsyncMove(Color color, Move move);
@@ -32,10 +51,32 @@ class ChessGame : base::NONCOPYABLE {
 
     State getState() const;
 
+    /**
+     * @brief Result of the game according to the current position and the positions before it
+     */
+    GameResult getResult() const;
+
+    /**
+     * @brief Plays a game from the given position to its end without any output or history
+     *
+     * Meant for random playouts and rollouts where only the outcome matters. The moves are generated once
+     * per ply and also decide whether the game is over. Only the Zobrist keys of the positions are recorded
+     * to end the game on threefold repetition.
+     *
+     * @param board  Start position, copied
+     * @param white  Player for the white pieces, must support getMove()
+     * @param black  Player for the black pieces, must support getMove()
+     * @param withHash  Also return the Zobrist hash of the final position
+     * @param maxPlies  Stop after this many plies with an undecided result, 0 for no limit
+     * @return PlayoutResult Result and number of plies played
+     */
+    static PlayoutResult playout(Board board, ChessPlayer& white, ChessPlayer& black, bool withHash = false, uint32_t maxPlies = 0);
+
    private:
     Board _board;
     ChessPlayer& _white;
     ChessPlayer& _black;
     ChessGameProgress _progress;
+    RepetitionHistory _repetitions;
     State _state;
 };
\ No newline at end of file
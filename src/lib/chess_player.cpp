@@ -10,6 +10,7 @@
 #include "base/helpers.h"
 #include "fmt/core.h"
 #include "move_debug.h"
+#include "opening_book.h"
 #include "rules.h"
 
 template <typename Iter, typename RandomGenerator>
@@ -19,14 +20,6 @@ Iter select_randomly(Iter start, Iter end, RandomGenerator& g) {
     return start;
 }
 
-template <typename Iter>
-Iter select_randomly(Iter start, Iter end) {
-    static std::random_device r;
-    std::seed_seq seed2{r(), r(), r(), r(), r(), r(), r(), r()};
-    static std::default_random_engine gen(seed2);
-    return select_randomly(start, end, gen);
-}
-
 ChessPlayer::ChessPlayer(const std::string& name) : _name(name) {}
 
 const std::string& ChessPlayer::getName() const { return _name; }
@@ -38,11 +31,13 @@ Move PickFirstChessPlayer::getMove(const Board&, const std::vector<Move>& potent
     return potentialMoves[0];
 }
 
-PickRandomChessPlayer::PickRandomChessPlayer(const std::string& name) : ChessPlayer(name) {}
+PickRandomChessPlayer::PickRandomChessPlayer(const std::string& name) : PickRandomChessPlayer(name, std::random_device{}()) {}
+
+PickRandomChessPlayer::PickRandomChessPlayer(const std::string& name, uint64_t seed) : ChessPlayer(name), _random(seed) {}
 
 Move PickRandomChessPlayer::getMove(const Board&, const std::vector<Move>& potentialMoves) {
     assert(potentialMoves.size() > 0);
-    return *select_randomly(potentialMoves.begin(), potentialMoves.end());
+    return *select_randomly(potentialMoves.begin(), potentialMoves.end(), _random);
 }
 
 OneMoveDeepBestPositionChessPlayer::OneMoveDeepBestPositionChessPlayer(const std::string& name) : ChessPlayer(name) {}
@@ -63,6 +58,29 @@ Move OneMoveDeepBestPositionChessPlayer::getMove(const Board& board, const std::
     return potentialMoves[std::distance(ratingsInMyFavor.begin(), maxIt)];
 }
 
+BookChessPlayer::BookChessPlayer(const PolyglotBook& book, ChessPlayer& fallback)
+    : ChessPlayer(fallback.getName()), _book(book), _fallback(fallback), _random(std::random_device{}()) {}
+
+const std::string& BookChessPlayer::getName() const { return _fallback.getName(); }
+
+void BookChessPlayer::seed(uint64_t seed) {
+    _random.seed(seed);
+    _fallback.seed(seed);
+}
+
+Move BookChessPlayer::getMove(const Board& board, const std::vector<Move>& potentialMoves) {
+    assert(potentialMoves.size() > 0);
+    auto bookMove = _book.pickMove(board, _random());
+    if (bookMove) {
+        // Potential moves might be annotated differently, so compare the plain move
+        auto it = std::find_if(potentialMoves.begin(), potentialMoves.end(), [&bookMove](const Move& move) {
+            return PolyglotBook::encodeMove(move) == PolyglotBook::encodeMove(*bookMove);
+        });
+        if (it != potentialMoves.end()) return *it;
+    }
+    return _fallback.getMove(board, potentialMoves);
+}
+
 HumanConsolePlayer::HumanConsolePlayer(const std::string& name) : ChessPlayer(name) {}
 
 Move HumanConsolePlayer::getMove(const Board&, const std::vector<Move>& potentialMoves) {
@@ -1,10 +1,14 @@
 #pragma once
+#include <cstdint>
+#include <random>
 #include <string>
 #include <vector>
 
 #include "board.h"
 #include "move.h"
 
+class PolyglotBook;
+
 class ChessPlayer {
    public:
     ChessPlayer() = delete;
@@ -14,6 +18,11 @@ class ChessPlayer {
     virtual Move getMove(const Board& board, const std::vector<Move>& potentialMoves) = 0;
     virtual bool useGetMove() { return true; }
 
+    /**
+     * @brief Reseed the random generator of a player that plays randomly, so games can be reproduced
+     */
+    virtual void seed(uint64_t) {}
+
    private:
     std::string _name;
 };
@@ -28,8 +37,13 @@ class PickFirstChessPlayer : public ChessPlayer {
 class PickRandomChessPlayer : public ChessPlayer {
    public:
     PickRandomChessPlayer(const std::string& name);
+    PickRandomChessPlayer(const std::string& name, uint64_t seed);
 
     Move getMove(const Board& board, const std::vector<Move>& potentialMoves) override;
+    void seed(uint64_t seed) override { _random.seed(seed); }
+
+   private:
+    std::mt19937_64 _random;
 };
 
 class OneMoveDeepBestPositionChessPlayer : public ChessPlayer {
@@ -39,6 +53,26 @@ class OneMoveDeepBestPositionChessPlayer : public ChessPlayer {
     Move getMove(const Board& board, const std::vector<Move>& potentialMoves) override;
 };
 
+/**
+ * @brief Plays from an opening book as long as the position is in it, then asks another player
+ *
+ * Wraps any other player, e.g. BookChessPlayer{book, randomPlayer}. The book must outlive the player.
+ */
+class BookChessPlayer : public ChessPlayer {
+   public:
+    BookChessPlayer(const PolyglotBook& book, ChessPlayer& fallback);
+
+    const std::string& getName() const override;
+    Move getMove(const Board& board, const std::vector<Move>& potentialMoves) override;
+    bool useGetMove() override { return _fallback.useGetMove(); }
+    void seed(uint64_t seed) override;
+
+   private:
+    const PolyglotBook& _book;
+    ChessPlayer& _fallback;
+    std::mt19937_64 _random;
+};
+
 class HumanConsolePlayer : public ChessPlayer {
    public:
     HumanConsolePlayer(const std::string& name);
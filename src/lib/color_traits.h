@@ -0,0 +1,29 @@
+#pragma once
+#include "board.h"
+#include "types.h"
+
+/**
+ * @brief Side dependent constants for code that is instantiated per side to move
+ */
+template <Color color>
+struct ColorTraits {
+    static constexpr bool isWhite = (color == Color::WHITE);
+    static constexpr Color opponent = isWhite ? Color::BLACK : Color::WHITE;
+    static constexpr int pawnDirection = isWhite ? 1 : -1;
+    static constexpr ChessRank baseRank = isWhite ? 1 : 8;
+    static constexpr ChessRank doubleStepRank = isWhite ? 2 : 7;
+    static constexpr ChessRank promotionRank = isWhite ? 8 : 1;
+    static constexpr Board::Castling castlingShort = isWhite ? Board::Castling::WHITE_SHORT : Board::Castling::BLACK_SHORT;
+    static constexpr Board::Castling castlingLong = isWhite ? Board::Castling::WHITE_LONG : Board::Castling::BLACK_LONG;
+};
+
+/**
+ * @brief Calls the templated lambda with the color as compile-time constant
+ *
+ * Usage: dispatchColor(board.whosTurnIsIt(), [&]<Color color>() { ... });
+ */
+template <typename Function>
+decltype(auto) dispatchColor(Color color, Function&& function) {
+    if (color == Color::WHITE) return function.template operator()<Color::WHITE>();
+    return function.template operator()<Color::BLACK>();
+}
@@ -0,0 +1,278 @@
+#include "fen.h"
+
+#include "board.h"
+
+static bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+static std::optional<ChessPiece> pieceFromFENChar(char c) {
+    switch (c) {
+        case 'P':
+            return ChessPiece{Color::WHITE, Piece::PAWN};
+        case 'N':
+            return ChessPiece{Color::WHITE, Piece::KNIGHT};
+        case 'B':
+            return ChessPiece{Color::WHITE, Piece::BISHOP};
+        case 'R':
+            return ChessPiece{Color::WHITE, Piece::ROOK};
+        case 'Q':
+            return ChessPiece{Color::WHITE, Piece::QUEEN};
+        case 'K':
+            return ChessPiece{Color::WHITE, Piece::KING};
+        case 'p':
+            return ChessPiece{Color::BLACK, Piece::PAWN};
+        case 'n':
+            return ChessPiece{Color::BLACK, Piece::KNIGHT};
+        case 'b':
+            return ChessPiece{Color::BLACK, Piece::BISHOP};
+        case 'r':
+            return ChessPiece{Color::BLACK, Piece::ROOK};
+        case 'q':
+            return ChessPiece{Color::BLACK, Piece::QUEEN};
+        case 'k':
+            return ChessPiece{Color::BLACK, Piece::KING};
+        default:
+            return std::nullopt;
+    }
+}
+
+namespace {
+/**
+ * @brief Cursor over the FEN string, fields are separated by any amount of whitespace
+ */
+class FenScanner {
+   public:
+    explicit FenScanner(std::string_view fen) : _fen(fen) {}
+
+    size_t position() const { return _pos; }
+    bool atEnd() const { return _pos == _fen.size(); }
+    char peek() const { return _fen[_pos]; }
+    char get() { return _fen[_pos++]; }
+
+    /**
+     * @brief Skip the whitespace in front of the next field
+     *
+     * @return bool - Is there another field?
+     */
+    bool nextField() {
+        while (!atEnd() && isSpace(peek())) ++_pos;
+        return !atEnd();
+    }
+    bool atFieldEnd() const { return atEnd() || isSpace(peek()); }
+
+    bool readNumber(uint32_t& number) {
+        if (atFieldEnd()) return false;
+        // Some tools write a dash for unknown counters
+        if (peek() == '-') {
+            get();
+            number = 0;
+            return atFieldEnd();
+        }
+        uint64_t value = 0;
+        while (!atFieldEnd()) {
+            char c = get();
+            if (c < '0' || c > '9') return false;
+            value = value * 10 + (c - '0');
+            if (value > UINT32_MAX) return false;
+        }
+        number = static_cast<uint32_t>(value);
+        return true;
+    }
+
+   private:
+    std::string_view _fen;
+    size_t _pos = 0;
+};
+}  // namespace
+
+FenResult Fen::parse(std::string_view fen, Board& board) {
+    FenScanner scanner(fen);
+    Board parsed;
+
+    // Piece placement, from rank 8 down to rank 1
+    scanner.nextField();
+    ChessRank rank = 8;
+    ChessFile file = A;
+    while (!scanner.atFieldEnd()) {
+        size_t position = scanner.position();
+        char c = scanner.get();
+        if (c == '/') {
+            if (file <= H) return {FenError::RANK_TOO_SHORT, position};
+            if (--rank < 1) return {FenError::WRONG_NUMBER_OF_RANKS, position};
+            file = A;
+        } else if (c >= '1' && c <= '8') {
+            file += c - '0';
+            if (file > H + 1) return {FenError::RANK_TOO_LONG, position};
+        } else if (auto piece = pieceFromFENChar(c)) {
+            if (file > H) return {FenError::RANK_TOO_LONG, position};
+            parsed._board[Square(file++, rank).index()] = *piece;
+        } else {
+            return {FenError::INVALID_PIECE, position};
+        }
+    }
+    if (file <= H) return {FenError::RANK_TOO_SHORT, scanner.position()};
+    if (rank != 1) return {FenError::WRONG_NUMBER_OF_RANKS, scanner.position()};
+
+    // Side to move
+    if (scanner.nextField()) {
+        size_t position = scanner.position();
+        char c = scanner.get();
+        if ((c != 'w' && c != 'b') || !scanner.atFieldEnd()) return {FenError::INVALID_TURN, position};
+        parsed._whosTurn = (c == 'w' ? Color::WHITE : Color::BLACK);
+    }
+
+    // Castling rights
+    if (scanner.nextField()) {
+        if (scanner.peek() == '-') {
+            scanner.get();
+            if (!scanner.atFieldEnd()) return {FenError::INVALID_CASTLING, scanner.position()};
+        } else {
+            while (!scanner.atFieldEnd()) {
+                size_t position = scanner.position();
+                Board::Castling castling;
+                switch (scanner.get()) {
+                    case 'K':
+                        castling = Board::Castling::WHITE_SHORT;
+                        break;
+                    case 'Q':
+                        castling = Board::Castling::WHITE_LONG;
+                        break;
+                    case 'k':
+                        castling = Board::Castling::BLACK_SHORT;
+                        break;
+                    case 'q':
+                        castling = Board::Castling::BLACK_LONG;
+                        break;
+                    default:
+                        return {FenError::INVALID_CASTLING, position};
+                }
+                if (parsed.canCastle(castling)) return {FenError::INVALID_CASTLING, position};
+                parsed.setCastling(castling);
+            }
+        }
+    }
+
+    // En-passant target
+    if (scanner.nextField()) {
+        size_t position = scanner.position();
+        char fileChar = scanner.get();
+        if (fileChar != '-') {
+            char rankChar = (scanner.atFieldEnd() ? ' ' : scanner.get());
+            if (fileChar < 'a' || fileChar > 'h' || (rankChar != '3' && rankChar != '6')) return {FenError::INVALID_EN_PASSANT, position};
+            parsed._enpassantTarget = ChessField{fileChar - 'a' + A, rankChar - '0'};
+        }
+        if (!scanner.atFieldEnd()) return {FenError::INVALID_EN_PASSANT, position};
+    }
+
+    if (scanner.nextField()) {
+        size_t position = scanner.position();
+        if (!scanner.readNumber(parsed._halfmoveClock)) return {FenError::INVALID_HALFMOVE_CLOCK, position};
+    }
+
+    if (scanner.nextField()) {
+        size_t position = scanner.position();
+        if (!scanner.readNumber(parsed._fullMoves)) return {FenError::INVALID_FULLMOVE_NUMBER, position};
+    }
+
+    if (scanner.nextField()) return {FenError::TRAILING_CHARACTERS, scanner.position()};
+
+    board = parsed;
+    return {};
+}
+
+std::string_view Fen::describe(FenError error) {
+    switch (error) {
+        case FenError::NONE:
+            return "no error";
+        case FenError::INVALID_PIECE:
+            return "invalid piece";
+        case FenError::RANK_TOO_LONG:
+            return "rank has more than 8 fields";
+        case FenError::RANK_TOO_SHORT:
+            return "rank has less than 8 fields";
+        case FenError::WRONG_NUMBER_OF_RANKS:
+            return "board does not have 8 ranks";
+        case FenError::INVALID_TURN:
+            return "side to move is not w or b";
+        case FenError::INVALID_CASTLING:
+            return "invalid castling rights";
+        case FenError::INVALID_EN_PASSANT:
+            return "invalid en-passant target";
+        case FenError::INVALID_HALFMOVE_CLOCK:
+            return "invalid halfmove clock";
+        case FenError::INVALID_FULLMOVE_NUMBER:
+            return "invalid fullmove number";
+        case FenError::TRAILING_CHARACTERS:
+            return "unexpected characters after the fullmove number";
+    }
+    return "unknown error";
+}
+
+static char fenCharFromPiece(ChessPiece piece) {
+    static constexpr char whitePieces[] = {'P', 'R', 'N', 'B', 'Q', 'K', '?'};
+    char c = whitePieces[static_cast<int>(std::get<PieceIdx>(piece))];
+    return std::get<ColorIdx>(piece) == Color::WHITE ? c : static_cast<char>(c - 'A' + 'a');
+}
+
+static char* writeNumber(char* out, uint32_t number) {
+    char digits[10];
+    int count = 0;
+    do {
+        digits[count++] = static_cast<char>('0' + number % 10);
+        number /= 10;
+    } while (number > 0);
+    while (count > 0) *out++ = digits[--count];
+    return out;
+}
+
+std::string_view Fen::write(const Board& board, Buffer& buffer, bool includeMoveCount) {
+    char* out = buffer.data();
+
+    for (ChessRank rank = 8; rank > 0; --rank) {
+        if (rank != 8) *out++ = '/';
+        int empty = 0;
+        for (ChessFile file = A; file <= H; ++file) {
+            PieceCode piece = board.getPieceCode({file, rank});
+            if (!piece) {
+                ++empty;
+                continue;
+            }
+            if (empty > 0) *out++ = static_cast<char>('0' + empty);
+            empty = 0;
+            *out++ = fenCharFromPiece(piece);
+        }
+        if (empty > 0) *out++ = static_cast<char>('0' + empty);
+    }
+
+    *out++ = ' ';
+    *out++ = (board.whosTurnIsIt() == Color::WHITE ? 'w' : 'b');
+    *out++ = ' ';
+    char* castlingStart = out;
+    if (board.canCastle(Board::Castling::WHITE_LONG)) *out++ = 'Q';
+    if (board.canCastle(Board::Castling::WHITE_SHORT)) *out++ = 'K';
+    if (board.canCastle(Board::Castling::BLACK_LONG)) *out++ = 'q';
+    if (board.canCastle(Board::Castling::BLACK_SHORT)) *out++ = 'k';
+    if (out == castlingStart) *out++ = '-';
+
+    *out++ = ' ';
+    if (board._enpassantTarget) {
+        *out++ = static_cast<char>('a' + std::get<ChessFileIdx>(*board._enpassantTarget) - A);
+        *out++ = static_cast<char>('0' + std::get<ChessRankIdx>(*board._enpassantTarget));
+    } else {
+        *out++ = '-';
+    }
+
+    if (includeMoveCount) {
+        *out++ = ' ';
+        out = writeNumber(out, board._halfmoveClock);
+        *out++ = ' ';
+        out = writeNumber(out, board._fullMoves);
+    }
+
+    return std::string_view(buffer.data(), out - buffer.data());
+}
+
+void Fen::append(fmt::memory_buffer& out, const Board& board, bool includeMoveCount) {
+    Buffer buffer;
+    std::string_view fen = write(board, buffer, includeMoveCount);
+    out.append(fen.data(), fen.data() + fen.size());
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <fmt/format.h>
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+class Board;
+
+enum class FenError {
+    NONE,
+    INVALID_PIECE,
+    RANK_TOO_LONG,
+    RANK_TOO_SHORT,
+    WRONG_NUMBER_OF_RANKS,
+    INVALID_TURN,
+    INVALID_CASTLING,
+    INVALID_EN_PASSANT,
+    INVALID_HALFMOVE_CLOCK,
+    INVALID_FULLMOVE_NUMBER,
+    TRAILING_CHARACTERS
+};
+
+/**
+ * @brief Outcome of parsing a FEN string
+ */
+struct FenResult {
+    FenError error = FenError::NONE;
+    size_t position = 0;  ///< Offset of the offending character in the FEN string
+
+    explicit operator bool() const { return error == FenError::NONE; }
+};
+
+/**
+ * @brief Parser and writer for FEN strings (https://www.chess.com/terms/fen-chess)
+ *
+ * Parses in a single pass over the string without allocating. Only the piece placement is mandatory,
+ * the side to move, castling rights, en-passant target, halfmove clock and fullmove number may be left
+ * out from the end. Bad input is reported, never asserted on.
+ *
+ * Writing renders into a fixed-size buffer on the stack or appends to a fmt::memory_buffer, so it does
+ * not allocate either.
+ */
+class Fen {
+   public:
+    /// Longest possible FEN: 64 pieces plus 7 slashes, the other fields and two 10 digit counters
+    static constexpr size_t MaxLength = 104;
+    using Buffer = std::array<char, MaxLength>;
+
+    /**
+     * @brief Parse a FEN string into a board
+     *
+     * @param fen    e.g. "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1"
+     * @param board  Receives the position. It is only changed if the string is valid.
+     * @return FenResult Error and its position, evaluates to true on success
+     */
+    static FenResult parse(std::string_view fen, Board& board);
+
+    /**
+     * @brief Human readable description of an error
+     */
+    static std::string_view describe(FenError error);
+
+    /**
+     * @brief Render the FEN string of a board into a buffer
+     *
+     * @param board             The board to describe
+     * @param buffer            Receives the string
+     * @param includeMoveCount  Also write the halfmove clock and the fullmove number
+     * @return std::string_view The FEN string, pointing into the buffer
+     */
+    static std::string_view write(const Board& board, Buffer& buffer, bool includeMoveCount = false);
+
+    /**
+     * @brief Append the FEN string of a board to a buffer
+     */
+    static void append(fmt::memory_buffer& out, const Board& board, bool includeMoveCount = false);
+};
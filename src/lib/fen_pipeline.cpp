@@ -0,0 +1,175 @@
+#include "fen_pipeline.h"
+
+#include <fmt/ranges.h>
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "board.h"
+#include "board_debug.h"
+#include "fen.h"
+#include "move_debug.h"
+#include "rules.h"
+
+namespace {
+struct Chunk {
+    size_t sequence = 0;
+    size_t lines = 0;
+    std::string input;
+    fmt::memory_buffer output;
+};
+}  // namespace
+
+FenPipeline::FenPipeline(const FenPipelineOptions& options) : _options(options) {}
+
+void FenPipeline::analyzeLine(std::string_view fen, fmt::memory_buffer& out, bool quiet) {
+    auto outIt = std::back_inserter(out);
+    Board board;
+    FenResult result = Fen::parse(fen, board);
+    if (!result) {
+        fmt::format_to(outIt, "Invalid FEN String {}: {} at position {}\n", fen, Fen::describe(result.error), result.position);
+        return;
+    }
+    if (!quiet) fmt::format_to(outIt, "FEN String {}\n{}", fen, board);
+
+    IllegalityReason illegality = ChessRules::findIllegalityReason(board);
+    bool legalPosition = (illegality == IllegalityReason::NONE);
+    if (!quiet) {
+        if (legalPosition) {
+            fmt::format_to(outIt, "Board position is legal\n");
+        } else {
+            fmt::format_to(outIt, "Board position is illegal: {}\n", ChessRules::describe(illegality));
+        }
+    }
+
+    if (legalPosition) {
+        auto validMoves = ChessRules::getAllValidMoves(board);
+        if (!quiet)
+            fmt::format_to(outIt, "Valid moves for  {}: {}\n", (board.whosTurnIsIt() == Color::WHITE ? "white" : "black"), validMoves);
+    }
+}
+
+size_t FenPipeline::run(std::istream& input, std::ostream& output) {
+    unsigned threads = (_options.threads > 0 ? _options.threads : std::max(1u, std::thread::hardware_concurrency()));
+    size_t queueDepth = (_options.queueDepth > 0 ? _options.queueDepth : 4 * threads);
+
+    std::mutex mutex;
+    std::condition_variable chunkFree, workAvailable, chunkDone;
+    std::vector<std::unique_ptr<Chunk>> freeChunks;
+    std::deque<std::unique_ptr<Chunk>> work;
+    std::vector<std::unique_ptr<Chunk>> done(queueDepth);  // ring buffer indexed by sequence
+    size_t chunksInFlight = 0;
+    bool inputDone = false;
+    size_t totalLines = 0;
+
+    auto worker = [&]() {
+        while (true) {
+            std::unique_ptr<Chunk> chunk;
+            {
+                std::unique_lock lock(mutex);
+                workAvailable.wait(lock, [&] { return !work.empty() || inputDone; });
+                if (work.empty()) return;
+                chunk = std::move(work.front());
+                work.pop_front();
+            }
+
+            chunk->output.clear();
+            chunk->lines = 0;
+            std::string_view text = chunk->input;
+            while (!text.empty()) {
+                size_t lineEnd = text.find('\n');
+                std::string_view line = text.substr(0, lineEnd);
+                text.remove_prefix(lineEnd == std::string_view::npos ? text.size() : lineEnd + 1);
+                if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+                if (line.empty()) continue;
+                analyzeLine(line, chunk->output, _options.quiet);
+                ++chunk->lines;
+            }
+
+            std::lock_guard lock(mutex);
+            size_t slot = chunk->sequence % queueDepth;
+            done[slot] = std::move(chunk);
+            chunkDone.notify_all();
+        }
+    };
+
+    size_t chunksRead = 0;
+    auto writer = [&]() {
+        for (size_t sequence = 0;; ++sequence) {
+            std::unique_ptr<Chunk> chunk;
+            {
+                std::unique_lock lock(mutex);
+                size_t slot = sequence % queueDepth;
+                chunkDone.wait(lock, [&] { return done[slot] != nullptr || (inputDone && sequence == chunksRead); });
+                if (done[slot] == nullptr) return;
+                chunk = std::move(done[slot]);
+            }
+
+            output.write(chunk->output.data(), chunk->output.size());
+            totalLines += chunk->lines;
+
+            std::lock_guard lock(mutex);
+            freeChunks.push_back(std::move(chunk));
+            --chunksInFlight;
+            chunkFree.notify_one();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned i = 0; i < threads; ++i) workers.emplace_back(worker);
+    std::thread writerThread(writer);
+
+    // Reader: fill chunks with whole lines, the partial line at the end moves on to the next chunk
+    std::string carry;
+    while (input) {
+        std::unique_ptr<Chunk> chunk;
+        {
+            std::unique_lock lock(mutex);
+            chunkFree.wait(lock, [&] { return chunksInFlight < queueDepth; });
+            ++chunksInFlight;
+            if (!freeChunks.empty()) {
+                chunk = std::move(freeChunks.back());
+                freeChunks.pop_back();
+            }
+        }
+        if (!chunk) chunk = std::make_unique<Chunk>();
+
+        chunk->input.swap(carry);
+        size_t offset = chunk->input.size();
+        chunk->input.resize(offset + _options.chunkSize);
+        input.read(chunk->input.data() + offset, _options.chunkSize);
+        chunk->input.resize(offset + input.gcount());
+
+        if (input) {
+            // Lines longer than a chunk are carried on until their end was read
+            size_t lineEnd = chunk->input.rfind('\n');
+            carry.assign(chunk->input, (lineEnd == std::string::npos ? 0 : lineEnd + 1));
+            chunk->input.resize(lineEnd == std::string::npos ? 0 : lineEnd + 1);
+        }
+
+        std::lock_guard lock(mutex);
+        if (chunk->input.empty()) {
+            freeChunks.push_back(std::move(chunk));
+            --chunksInFlight;
+            continue;
+        }
+        chunk->sequence = chunksRead++;
+        work.push_back(std::move(chunk));
+        workAvailable.notify_one();
+    }
+
+    {
+        std::lock_guard lock(mutex);
+        inputDone = true;
+        workAvailable.notify_all();
+        chunkDone.notify_all();
+    }
+    for (std::thread& thread : workers) thread.join();
+    writerThread.join();
+
+    return totalLines;
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <fmt/format.h>
+
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <string_view>
+
+#include "base/helpers.h"
+
+struct FenPipelineOptions {
+    unsigned threads = 0;        ///< Worker threads, 0 means one per hardware thread
+    size_t queueDepth = 0;       ///< Chunks in flight between reader and writer, 0 means four per worker
+    size_t chunkSize = 1 << 16;  ///< Bytes of input per chunk, a chunk always ends at a line break
+    bool quiet = false;          ///< Analyze but only report invalid FEN strings
+};
+
+/**
+ * @brief Analyzes FEN strings line by line: parses them, checks the legality and lists the valid moves
+ *
+ * Runs as a pipeline. The calling thread reads the input in chunks of whole lines, a pool of workers
+ * analyzes the chunks and renders their output into per-chunk buffers, and a writer thread emits the
+ * buffers in input order. At most queueDepth chunks are in flight, which bounds the memory use.
+ */
+class FenPipeline : base::NONCOPYABLE {
+   public:
+    explicit FenPipeline(const FenPipelineOptions& options = {});
+
+    /**
+     * @brief Analyze all lines of the input
+     *
+     * @return size_t Number of analyzed lines
+     */
+    size_t run(std::istream& input, std::ostream& output);
+
+    /**
+     * @brief Analyze a single FEN string and append the report to a buffer
+     */
+    static void analyzeLine(std::string_view fen, fmt::memory_buffer& out, bool quiet);
+
+   private:
+    FenPipelineOptions _options;
+};
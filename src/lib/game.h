@@ -1,31 +1,50 @@
 #pragma once
 #include <base/helpers.h>
 
-#include <memory>
-#include <optional>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <vector>
 
+/**
+ * @brief View on a single state of a game
+ *
+ * The pointers stay valid until the next move is added to the game.
+ */
 template <class TGameState, class TMove, class TExtraData>
 struct GameState {
-    using MyType = GameState<TGameState, TMove, TExtraData>;
-
-    std::shared_ptr<TGameState> content = nullptr;
-    std::shared_ptr<TMove> moveToNext = nullptr;
-    std::shared_ptr<MyType> prev = nullptr;
-    std::shared_ptr<MyType> next = nullptr;
-    std::shared_ptr<TExtraData> data = nullptr;
+    const TGameState* content = nullptr;
+    const TMove* moveToNext = nullptr;  ///< nullptr for the current state
+    const TExtraData* data = nullptr;
+    size_t index = 0;  ///< 0 for the root state
 };
 
+template <class TGameState, class TMove, class TExtraData>
+class Game;
+
 template <class TGameState, class TMove, class TExtraData>
 class GameStateIterator {
    public:
     using State = GameState<TGameState, TMove, TExtraData>;
-    GameStateIterator(std::shared_ptr<State> curr) : _curr(curr) {}
-    GameStateIterator(GameStateIterator& orig) : _curr(orig._curr) {}
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = State;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const State*;
+    using reference = State;
+
+    // Allows it->moveToNext although the state is created on the fly
+    struct ArrowProxy {
+        State state;
+        const State* operator->() const { return &state; }
+    };
+
+    GameStateIterator() = default;
+    GameStateIterator(const Game<TGameState, TMove, TExtraData>* game, size_t index) : _game(game), _index(index) {}
 
+    bool operator==(const GameStateIterator& other) const { return _index == other._index; }
     bool operator!=(const GameStateIterator& other) const { return !operator==(other); }
-    bool operator==(const GameStateIterator& other) const { return _curr == other._curr; }
     GameStateIterator& operator++() {
-        if (_curr != nullptr) _curr = _curr->next;
+        ++_index;
         return *this;
     }
 
@@ -35,12 +54,20 @@ class GameStateIterator {
         return old;
     }
 
-    std::shared_ptr<State> operator*() { return _curr; }
+    State operator*() const { return _game->getState(_index); }
+    ArrowProxy operator->() const { return {operator*()}; }
 
    private:
-    std::shared_ptr<State> _curr;
+    const Game<TGameState, TMove, TExtraData>* _game = nullptr;
+    size_t _index = 0;
 };
 
+/**
+ * @brief History of a game: the root state and every move with the state it resulted in
+ *
+ * States, moves and extra data are kept in one vector each, so adding a move does not allocate
+ * besides the occasional growth of the vectors, and iterating is a walk over contiguous memory.
+ */
 template <class TGameState, class TMove, class TExtraData>
 class Game : public base::NONCOPYANDMOVEABLE {
    public:
@@ -49,26 +76,43 @@ class Game : public base::NONCOPYANDMOVEABLE {
     using Iterator = GameStateIterator<TGameState, TMove, TExtraData>;
 
     Game() = delete;
-    Game(const TGameState& rootState, const TExtraData& extraData) : _root(std::make_shared<State>()), _last(_root) {
-        _root->content = std::make_shared<TGameState>(rootState);
-        _root->data = std::make_shared<TExtraData>(extraData);
+    Game(const TGameState& rootState, const TExtraData& extraData) {
+        _states.push_back(rootState);
+        _data.push_back(extraData);
     }
 
     void addMove(const TMove& move, const TGameState& resultingState, const TExtraData& extraData) {
-        std::shared_ptr<State> oldLast = _last;
-        _last = std::make_shared<State>();
-        _last->content = std::make_shared<TGameState>(resultingState);
-        _last->data = std::make_shared<TExtraData>(extraData);
-        _last->prev = oldLast;
-        oldLast->next = _last;
-        oldLast->moveToNext = std::make_shared<TMove>(move);
+        _moves.push_back(move);
+        _states.push_back(resultingState);
+        _data.push_back(extraData);
+    }
+
+    /**
+     * @brief Reserve memory for the given number of moves
+     */
+    void reserve(size_t moves) {
+        _moves.reserve(moves);
+        _states.reserve(moves + 1);
+        _data.reserve(moves + 1);
+    }
+
+    /**
+     * @brief Number of states, which is one more than the number of moves
+     */
+    size_t size() const { return _states.size(); }
+    size_t getNumberOfMoves() const { return _moves.size(); }
+
+    State getState(size_t index) const {
+        assert(index < _states.size());
+        return State{&_states[index], index < _moves.size() ? &_moves[index] : nullptr, &_data[index], index};
     }
-    std::shared_ptr<State> getCurrentState() { return _last; }
+    State getCurrentState() const { return getState(_states.size() - 1); }
 
-    Iterator begin() { return Iterator{_root}; }
-    Iterator end() { return Iterator{nullptr}; }
+    Iterator begin() const { return Iterator{this, 0}; }
+    Iterator end() const { return Iterator{this, _states.size()}; }
 
    private:
-    std::shared_ptr<State> _root = nullptr;
-    std::shared_ptr<State> _last = nullptr;
+    std::vector<TGameState> _states;
+    std::vector<TMove> _moves;
+    std::vector<TExtraData> _data;
 };
@@ -0,0 +1,186 @@
+#pragma once
+#include <base/helpers.h>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Tree of game states with moves as edges, for analysis with variations
+ *
+ * Nodes and edges live in two vectors and refer to each other by 32 bit indices, so the tree is compact
+ * and never allocates per node. The edges leaving a node form a list of siblings, the first one is the
+ * main line and every further one a variation.
+ *
+ * With a key function (e.g. Zobrist::hash for chess) states with equal keys are stored only once, which
+ * turns the tree into a graph where transpositions share their node. The node keeps the state and data
+ * it was created with. Repetitions then become cycles.
+ */
+template <class TGameState, class TMove, class TExtraData>
+class GameTree : public base::NONCOPYABLE {
+   public:
+    using Index = uint32_t;
+    using KeyFunction = std::function<uint64_t(const TGameState&)>;
+    static constexpr Index Invalid = std::numeric_limits<Index>::max();
+
+    struct Edge {
+        TMove move;
+        Index child = Invalid;
+        Index nextSibling = Invalid;
+    };
+
+    class EdgeIterator {
+       public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Edge;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Edge*;
+        using reference = const Edge&;
+
+        EdgeIterator() = default;
+        EdgeIterator(const std::vector<Edge>* edges, Index edge) : _edges(edges), _edge(edge) {}
+
+        bool operator==(const EdgeIterator& other) const { return _edge == other._edge; }
+        bool operator!=(const EdgeIterator& other) const { return !operator==(other); }
+        EdgeIterator& operator++() {
+            _edge = (*_edges)[_edge].nextSibling;
+            return *this;
+        }
+        EdgeIterator operator++(int) {
+            EdgeIterator old = *this;
+            operator++();
+            return old;
+        }
+        const Edge& operator*() const { return (*_edges)[_edge]; }
+        const Edge* operator->() const { return &(*_edges)[_edge]; }
+
+       private:
+        const std::vector<Edge>* _edges = nullptr;
+        Index _edge = Invalid;
+    };
+
+    struct Children {
+        EdgeIterator first;
+        EdgeIterator begin() const { return first; }
+        EdgeIterator end() const { return EdgeIterator{}; }
+    };
+
+    GameTree() = delete;
+    GameTree(const TGameState& rootState, const TExtraData& extraData, KeyFunction key = {}) : _key(std::move(key)) {
+        _nodes.push_back(Node{rootState, extraData});
+        if (_key) _nodeByKey.emplace(_key(rootState), 0);
+    }
+
+    static constexpr Index root() { return 0; }
+
+    /**
+     * @brief Add a move from a node, as variation if the node already has moves
+     *
+     * If the move is already known at this node, nothing is added. With deduplication the move may lead
+     * to a node that already exists.
+     *
+     * @return Index Node the move leads to
+     */
+    Index addMove(Index parent, const TMove& move, const TGameState& resultingState, const TExtraData& extraData) {
+        assert(parent < _nodes.size());
+        Index existing = findChild(parent, move);
+        if (existing != Invalid) return existing;
+
+        Index child = Invalid;
+        if (_key) {
+            auto [it, inserted] = _nodeByKey.try_emplace(_key(resultingState), static_cast<Index>(_nodes.size()));
+            if (!inserted) child = it->second;
+        }
+        if (child == Invalid) {
+            assert(_nodes.size() < Invalid);
+            child = static_cast<Index>(_nodes.size());
+            _nodes.push_back(Node{resultingState, extraData, parent});
+        }
+
+        assert(_edges.size() < Invalid);
+        Index edge = static_cast<Index>(_edges.size());
+        _edges.push_back(Edge{move, child});
+        Node& parentNode = _nodes[parent];
+        if (parentNode.lastEdge == Invalid)
+            parentNode.firstEdge = edge;
+        else
+            _edges[parentNode.lastEdge].nextSibling = edge;
+        parentNode.lastEdge = edge;
+        return child;
+    }
+
+    /**
+     * @brief Node the move leads to from the given node, Invalid if the move was not added yet
+     */
+    Index findChild(Index parent, const TMove& move) const {
+        for (const Edge& edge : getChildren(parent)) {
+            if (edge.move == move) return edge.child;
+        }
+        return Invalid;
+    }
+
+    /**
+     * @brief Node with the given key, Invalid if there is none or the tree does not deduplicate
+     */
+    Index findNode(uint64_t key) const {
+        auto it = _nodeByKey.find(key);
+        return it == _nodeByKey.end() ? Invalid : it->second;
+    }
+
+    Children getChildren(Index node) const { return Children{EdgeIterator{&_edges, _nodes[node].firstEdge}}; }
+
+    /**
+     * @brief Node followed by the first child of every node, as long as there is one
+     *
+     * Stops at the first node that is already part of the line, as deduplication can create cycles.
+     */
+    std::vector<Index> getMainLine(Index from = root()) const {
+        std::vector<Index> line{from};
+        std::unordered_set<Index> visited{from};
+        while (_nodes[line.back()].firstEdge != Invalid) {
+            Index next = _edges[_nodes[line.back()].firstEdge].child;
+            if (!visited.insert(next).second) break;
+            line.push_back(next);
+        }
+        return line;
+    }
+
+    const TGameState& getState(Index node) const { return _nodes[node].state; }
+    TExtraData& getData(Index node) { return _nodes[node].data; }
+    const TExtraData& getData(Index node) const { return _nodes[node].data; }
+
+    /**
+     * @brief Node the given node was first reached from, Invalid for the root
+     */
+    Index getParent(Index node) const { return _nodes[node].parent; }
+
+    size_t size() const { return _nodes.size(); }
+    size_t getNumberOfMoves() const { return _edges.size(); }
+
+    void reserve(size_t nodes, size_t moves) {
+        _nodes.reserve(nodes);
+        _edges.reserve(moves);
+        if (_key) _nodeByKey.reserve(nodes);
+    }
+
+   private:
+    struct Node {
+        TGameState state;
+        TExtraData data;
+        Index parent = Invalid;
+        Index firstEdge = Invalid;
+        Index lastEdge = Invalid;
+    };
+
+    KeyFunction _key;
+    std::vector<Node> _nodes;
+    std::vector<Edge> _edges;
+    std::unordered_map<uint64_t, Index> _nodeByKey;
+};
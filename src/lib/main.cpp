@@ -1,7 +1,10 @@
 #include <base/argparser.h>
 #include <base/improve_containers.h>
 
+#include <cstdio>
 #include <iostream>
+#include <memory>
+#include <random>
 
 #include "bench.h"
 #include "board.h"
@@ -9,33 +12,123 @@
 #include "board_factory.h"
 #include "chess_game.h"
 #include "chess_player.h"
+#include "fen.h"
+#include "fen_pipeline.h"
 #include "move.h"
 #include "move_debug.h"
+#include "packed_position.h"
+#include "position_dataset.h"
+#include "pgn.h"
 #include "rules.h"
+#include "self_play.h"
 #include "types.h"
 
 using base::argparser;
 
 base::BenchmarkStatistics CHESS_BENCH;
 
-void parseFENsFromStdin(bool quiet) {
+static constexpr size_t OUTPUT_FLUSH_SIZE = 1 << 20;
+
+void parseFENsFromStdin(const FenPipelineOptions& options) {
+    std::ios::sync_with_stdio(false);
+    FenPipeline pipeline{options};
+    pipeline.run(std::cin, std::cout);
+
+    CHESS_BENCH.printStatistics();
+}
+
+// FEN lines from stdin -> packed positions to stdout
+void packFENsFromStdin() {
+    std::ios::sync_with_stdio(false);
     std::string fen;
+    Board board;
 
     while (std::getline(std::cin, fen)) {
-        Board board = BoardFactory::createBoardFromFEN(fen);
-        if (!quiet) fmt::print("FEN String {}\n{}", fen, board);
+        if (!fen.empty() && fen.back() == '\r') fen.pop_back();
+        if (fen.empty()) continue;
+        FenResult result = Fen::parse(fen, board);
+        std::optional<PackedPosition> packed = (result ? PackedPosition::pack(board) : std::nullopt);
+        if (!packed) {
+            fmt::print(stderr, "Can not pack FEN String {}: {}\n", fen, (result ? "too many pieces" : Fen::describe(result.error)));
+            continue;
+        }
+        std::cout.write(reinterpret_cast<const char*>(packed->bytes.data()), PackedPosition::Size);
+    }
+}
 
-        bool legalPosition = board.isLegalPosition();
+// Packed positions from stdin -> FEN lines to stdout
+void unpackPositionsFromStdin() {
+    std::ios::sync_with_stdio(false);
+    PackedPosition packed;
+    Board board;
+    Fen::Buffer fenBuffer;
+    fmt::memory_buffer out;
+
+    while (std::cin.read(reinterpret_cast<char*>(packed.bytes.data()), PackedPosition::Size)) {
+        if (!PackedPosition::unpack(packed.bytes.data(), board)) {
+            fmt::print(stderr, "Invalid packed position\n");
+            continue;
+        }
+        fmt::format_to(std::back_inserter(out), "{}\n", Fen::write(board, fenBuffer, true));
+        if (out.size() > OUTPUT_FLUSH_SIZE) {
+            std::cout.write(out.data(), out.size());
+            out.clear();
+        }
+    }
+    std::cout.write(out.data(), out.size());
+}
 
-        if (!quiet) fmt::print("Board position is {}\n", (legalPosition ? "legal" : "illegal"));
+// FEN lines from stdin -> position dataset file
+void packFENsIntoDataset(const std::string& path) {
+    std::ios::sync_with_stdio(false);
+    PositionDatasetWriter writer;
+    if (!writer.open(path)) {
+        fmt::print(stderr, "Could not open {} for writing\n", path);
+        return;
+    }
 
-        if (legalPosition) {
-            auto validMoves = ChessRules::getAllValidMoves(board);
-            if (!quiet) fmt::print("Valid moves for  {}: {}", (board.whosTurnIsIt() == Color::WHITE ? "white" : "black"), validMoves);
+    std::string fen;
+    Board board;
+    while (std::getline(std::cin, fen)) {
+        if (!fen.empty() && fen.back() == '\r') fen.pop_back();
+        if (fen.empty()) continue;
+        FenResult result = Fen::parse(fen, board);
+        if (!result) {
+            fmt::print(stderr, "Invalid FEN String {}: {} at position {}\n", fen, Fen::describe(result.error), result.position);
+        } else if (!writer.add(board)) {
+            fmt::print(stderr, "Can not pack FEN String {}: too many pieces\n", fen);
         }
     }
 
-    CHESS_BENCH.printStatistics();
+    size_t positions = writer.size();
+    if (!writer.close()) fmt::print(stderr, "Could not write {}\n", path);
+    fmt::print(stderr, "Packed {} positions into {}\n", positions, path);
+}
+
+// Position dataset file -> FEN lines to stdout
+void unpackDatasetToStdout(const std::string& path) {
+    std::ios::sync_with_stdio(false);
+    PositionDataset dataset;
+    if (!dataset.open(path)) {
+        fmt::print(stderr, "{} is no position dataset\n", path);
+        return;
+    }
+
+    Board board;
+    Fen::Buffer fenBuffer;
+    fmt::memory_buffer out;
+    for (size_t i = 0; i < dataset.size(); ++i) {
+        if (!dataset.get(i, board)) {
+            fmt::print(stderr, "Invalid position at index {}\n", i);
+            continue;
+        }
+        fmt::format_to(std::back_inserter(out), "{}\n", Fen::write(board, fenBuffer, true));
+        if (out.size() > OUTPUT_FLUSH_SIZE) {
+            std::cout.write(out.data(), out.size());
+            out.clear();
+        }
+    }
+    std::cout.write(out.data(), out.size());
 }
 
 int main(int argc, char** argv) {
@@ -45,7 +138,21 @@ int main(int argc, char** argv) {
     parser.add_flag("help").short_option('h').description("Print help");
     parser.add_flag("game").short_option('g').description("Play a game of chess");
     parser.add_option<int>("sim").short_option('s').description("Simulate a number of automatic games").default_value(0);
+    parser.add_option<int>("seed").short_option('r').description("Base seed of the simulated games, random if negative").default_value(-1);
+    parser.add_option<std::string>("pgn").short_option('p').description("Write the simulated games to a PGN file").default_value("");
     parser.add_flag("fen").short_option('f').description("Parse FENs from stdin and print board plus possible moves.");
+    parser.add_flag("pack").short_option('b').description("Convert FENs from stdin into packed binary positions on stdout");
+    parser.add_flag("unpack").short_option('u').description("Convert packed binary positions from stdin into FENs on stdout");
+    parser.add_option<std::string>("pack-file").description("Pack FENs from stdin into a dataset file").default_value("");
+    parser.add_option<std::string>("unpack-file").description("Print the positions of a dataset file").default_value("");
+    parser.add_option<int>("threads")
+        .short_option('t')
+        .description("Worker threads for --fen and --sim, 0 for one per core")
+        .default_value(0);
+    parser.add_option<int>("queue-depth")
+        .short_option('d')
+        .description("Chunks of input in flight for --fen, 0 for four per thread")
+        .default_value(0);
 
     auto options = parser.parse(argc, argv);
 
@@ -55,7 +162,18 @@ int main(int argc, char** argv) {
     }
     bool quiet = options.is_flag_set("quiet");
 
-    if (options.is_flag_set("fen")) parseFENsFromStdin(quiet);
+    if (options.is_flag_set("pack")) packFENsFromStdin();
+    if (options.is_flag_set("unpack")) unpackPositionsFromStdin();
+    if (!options.get<std::string>("pack-file").empty()) packFENsIntoDataset(options.get<std::string>("pack-file"));
+    if (!options.get<std::string>("unpack-file").empty()) unpackDatasetToStdout(options.get<std::string>("unpack-file"));
+
+    if (options.is_flag_set("fen")) {
+        FenPipelineOptions pipelineOptions;
+        pipelineOptions.threads = std::max(0, options.get<int>("threads"));
+        pipelineOptions.queueDepth = std::max(0, options.get<int>("queue-depth"));
+        pipelineOptions.quiet = quiet;
+        parseFENsFromStdin(pipelineOptions);
+    }
 
     if (options.is_flag_set("game")) {
         OneMoveDeepBestPositionChessPlayer whitePlayer{"Andreas"};
@@ -63,13 +181,41 @@ int main(int argc, char** argv) {
         ChessGame game{whitePlayer, blackPlayer};
         game.startSyncronousGame();
     } else if (options.get<int>("sim") > 0) {
-        fmt::print("Simulate {} games\n", options.get<int>("sim"));
-        PickRandomChessPlayer whitePlayer{"Andreas"};
-        PickRandomChessPlayer blackPlayer{"Upasna"};
-        for (int i = options.get<int>("sim"); i > 0; --i) {
-            ChessGame game{whitePlayer, blackPlayer};
-            game.startSyncronousGame();
+        SelfPlayOptions simOptions;
+        simOptions.games = options.get<int>("sim");
+        simOptions.threads = std::max(0, options.get<int>("threads"));
+        simOptions.seed = (options.get<int>("seed") >= 0 ? options.get<int>("seed") : std::random_device{}());
+        fmt::print("Simulate {} games with seed {}\n", simOptions.games, simOptions.seed);
+
+        std::string pgnPath = options.get<std::string>("pgn");
+        std::FILE* pgnFile = (pgnPath.empty() ? nullptr : std::fopen(pgnPath.c_str(), "w"));
+        if (!pgnPath.empty() && pgnFile == nullptr) fmt::print("Could not open {} for writing\n", pgnPath);
+        PgnWriter pgnWriter;
+
+        SelfPlay selfPlay{[](Color color) { return std::make_unique<PickRandomChessPlayer>(color == Color::WHITE ? "Andreas" : "Upasna"); },
+                          simOptions};
+        auto onGameFinished = [&](int gameIndex, ChessGame& game) {
+            std::string_view result = PgnWriter::getResult(game.getResult());
+            if (!quiet) {
+                fmt::print("Game {}: {}\n", gameIndex + 1, result);
+                game.printResult();
+            }
+            if (pgnFile == nullptr) return;
+
+            pgnWriter.writeGame(game.getProgress(), {.round = std::to_string(gameIndex + 1),
+                                                     .white = game.getWhite().getName(),
+                                                     .black = game.getBlack().getName(),
+                                                     .result = std::string(result)});
+            if (pgnWriter.size() > OUTPUT_FLUSH_SIZE) pgnWriter.flush(pgnFile);
+        };
+        SelfPlayResults results = selfPlay.run(onGameFinished);
+
+        if (pgnFile != nullptr) {
+            pgnWriter.flush(pgnFile);
+            std::fclose(pgnFile);
         }
+        fmt::print("White won {}, black won {}, draws {}, average game length {:.1f} plies\n", results.whiteWins, results.blackWins,
+                   results.draws + results.undecided, static_cast<double>(results.plies) / results.games());
     }
 
     return 0;
@@ -0,0 +1,50 @@
+#include "mapped_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(const std::string& path) { open(path); }
+
+MappedFile::~MappedFile() { close(); }
+
+bool MappedFile::open(const std::string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    // mmap refuses empty files, but an empty file is still a valid (empty) file
+    if (st.st_size == 0) {
+        ::close(fd);
+        _isEmptyFile = true;
+        return true;
+    }
+
+    void* addr = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) return false;
+
+    _data = static_cast<const char*>(addr);
+    _size = static_cast<size_t>(st.st_size);
+    return true;
+}
+
+void MappedFile::close() {
+    if (_data != nullptr) ::munmap(const_cast<char*>(_data), _size);
+    _data = nullptr;
+    _size = 0;
+    _isEmptyFile = false;
+}
+
+void MappedFile::adviseAccess(Access access) const {
+    if (_data == nullptr) return;
+    ::madvise(const_cast<char*>(_data), _size, access == Access::RANDOM ? MADV_RANDOM : MADV_SEQUENTIAL);
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+#include "base/helpers.h"
+
+/**
+ * @brief Read-only memory mapping of a whole file
+ *
+ * Mapping is instant regardless of the file size. Pages are loaded on first access and are shared with
+ * the operating system's page cache, so huge files never have to be read into memory up front.
+ */
+class MappedFile : base::NONCOPYABLE {
+   public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    /**
+     * @brief Map a file, unmapping a previously mapped one
+     *
+     * @param path  Path of the file to map
+     * @return bool - Could the file be mapped?
+     */
+    bool open(const std::string& path);
+    void close();
+
+    enum class Access { RANDOM, SEQUENTIAL };
+    /**
+     * @brief Hint the kernel about the expected access pattern to tune read-ahead
+     */
+    void adviseAccess(Access access) const;
+
+    bool isOpen() const { return _data != nullptr || _isEmptyFile; }
+    const char* data() const { return _data; }
+    size_t size() const { return _size; }
+
+   private:
+    const char* _data = nullptr;
+    size_t _size = 0;
+    bool _isEmptyFile = false;
+};
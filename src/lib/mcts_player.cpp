@@ -0,0 +1,211 @@
+#include "mcts_player.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <optional>
+#include <thread>
+#include <utility>
+
+#include "chess_game.h"
+#include "move_list.h"
+#include "rules.h"
+
+enum class NodeState : uint8_t { UNEXPANDED, EXPANDING, EXPANDED };
+
+struct MCTSChessPlayer::Node {
+    std::optional<Move> move;  // Move leading to this node, empty for the root
+    std::atomic<uint32_t> visits{0};
+    std::atomic<uint32_t> virtualLoss{0};
+    std::atomic<uint32_t> score{0};  // Points of the side that played move, 2 per win and 1 per draw
+    std::atomic<NodeState> state{NodeState::UNEXPANDED};
+    // Only valid once state is EXPANDED
+    uint32_t firstChild = 0;
+    uint32_t childCount = 0;
+
+    void reset() {
+        move.reset();
+        visits = 0;
+        virtualLoss = 0;
+        score = 0;
+        state = NodeState::UNEXPANDED;
+        firstChild = 0;
+        childCount = 0;
+    }
+};
+
+namespace {
+/**
+ * @brief Plays random moves, but prefers captures a bit, so material is not given away for nothing
+ */
+class RolloutPlayer : public ChessPlayer {
+   public:
+    RolloutPlayer(uint64_t seed, double captureBias) : ChessPlayer("Rollout"), _random(seed), _captureBias(captureBias) {}
+
+    Move getMove(const Board&, const std::vector<Move>& potentialMoves) override {
+        assert(potentialMoves.size() > 0);
+        if (_captureBias > 0.0 && std::uniform_real_distribution<>{}(_random) < _captureBias) {
+            auto isCapture = [](const Move& move) { return move.hasModifier(MoveModifier::CAPTURE); };
+            auto captures = std::count_if(potentialMoves.begin(), potentialMoves.end(), isCapture);
+            if (captures > 0) {
+                auto pick = std::uniform_int_distribution<long>{0, captures - 1}(_random);
+                for (const Move& move : potentialMoves) {
+                    if (isCapture(move) && pick-- == 0) return move;
+                }
+            }
+        }
+        return potentialMoves[std::uniform_int_distribution<size_t>{0, potentialMoves.size() - 1}(_random)];
+    }
+
+   private:
+    std::mt19937_64 _random;
+    double _captureBias;
+};
+
+Color opposite(Color color) { return (color == Color::WHITE ? Color::BLACK : Color::WHITE); }
+
+uint32_t pointsFor(Color color, GameResult result) {
+    switch (result) {
+        case GameResult::WHITE_WINS:
+            return color == Color::WHITE ? 2 : 0;
+        case GameResult::BLACK_WINS:
+            return color == Color::BLACK ? 2 : 0;
+        default:
+            return 1;
+    }
+}
+}  // namespace
+
+MCTSChessPlayer::MCTSChessPlayer(const std::string& name, const MCTSOptions& options)
+    : MCTSChessPlayer(name, options, std::random_device{}()) {}
+
+MCTSChessPlayer::MCTSChessPlayer(const std::string& name, const MCTSOptions& options, uint64_t seed)
+    : ChessPlayer(name), _options(options), _random(seed), _nodes(std::make_unique<Node[]>(std::max(options.treeSize, 1u))) {
+    assert(_options.playouts > 0 || _options.moveTime.count() > 0);
+    _options.treeSize = std::max(_options.treeSize, 1u);
+    _options.threads = std::max(_options.threads, 1u);
+}
+
+MCTSChessPlayer::~MCTSChessPlayer() = default;
+
+uint64_t MCTSChessPlayer::getPlayouts() const { return _playouts; }
+
+uint32_t MCTSChessPlayer::getNodes() const { return std::min(_nodeCount.load(), _options.treeSize); }
+
+Move MCTSChessPlayer::getMove(const Board& board, const std::vector<Move>& potentialMoves) {
+    assert(potentialMoves.size() > 0);
+    for (uint32_t i = 0; i < getNodes(); ++i) _nodes[i].reset();
+    _nodeCount = 1;
+    _treeFull = false;
+    _startedPlayouts = 0;
+    _playouts = 0;
+    _startTime = std::chrono::steady_clock::now();
+    if (potentialMoves.size() == 1) return potentialMoves[0];
+
+    // The root children are the given moves in the given order, so the best child can be returned as is
+    Node& root = _nodes[0];
+    uint32_t rootChildren = std::min(static_cast<uint32_t>(potentialMoves.size()), _options.treeSize - 1);
+    for (uint32_t i = 0; i < rootChildren; ++i) _nodes[1 + i].move = potentialMoves[i];
+    root.firstChild = 1;
+    root.childCount = rootChildren;
+    root.state = NodeState::EXPANDED;
+    _nodeCount = 1 + rootChildren;
+    if (rootChildren == 0) return potentialMoves[0];
+
+    std::vector<std::thread> helpers;
+    for (unsigned i = 1; i < _options.threads; ++i) helpers.emplace_back(&MCTSChessPlayer::runWorker, this, std::cref(board), _random());
+    runWorker(board, _random());
+    for (std::thread& helper : helpers) helper.join();
+
+    uint32_t best = 0;
+    for (uint32_t i = 1; i < rootChildren; ++i) {
+        if (_nodes[1 + i].visits > _nodes[1 + best].visits) best = i;
+    }
+    return potentialMoves[best];
+}
+
+bool MCTSChessPlayer::isBudgetLeft() {
+    if (_options.moveTime.count() > 0 && std::chrono::steady_clock::now() - _startTime >= _options.moveTime) return false;
+    return _options.playouts == 0 || _startedPlayouts++ < _options.playouts;
+}
+
+bool MCTSChessPlayer::expand(Node& node, const Board& board) {
+    if (_treeFull) return false;
+    NodeState expected = NodeState::UNEXPANDED;
+    if (!node.state.compare_exchange_strong(expected, NodeState::EXPANDING)) return false;
+
+    MoveList moves;
+    ChessRules::getAllValidMoves(board, moves, false);
+    uint32_t count = static_cast<uint32_t>(moves.size());
+    uint32_t first = _nodeCount.fetch_add(count);
+    if (static_cast<uint64_t>(first) + count > _options.treeSize) {
+        // Nodes behind the capacity are never touched, so the counter may overshoot
+        _treeFull = true;
+        node.state = NodeState::UNEXPANDED;
+        return false;
+    }
+    for (uint32_t i = 0; i < count; ++i) _nodes[first + i].move = moves[i];
+    node.firstChild = first;
+    node.childCount = count;
+    node.state.store(NodeState::EXPANDED, std::memory_order_release);
+    return true;
+}
+
+uint32_t MCTSChessPlayer::select(const Node& node) const {
+    double logParentVisits = std::log(std::max(1u, node.visits + node.virtualLoss));
+    uint32_t best = node.firstChild;
+    double bestValue = -1.0;
+    for (uint32_t i = node.firstChild; i < node.firstChild + node.childCount; ++i) {
+        const Node& child = _nodes[i];
+        // Virtual loss counts as visits without points, which makes lines other threads play out less attractive
+        uint32_t visits = child.visits + child.virtualLoss;
+        if (visits == 0) return i;
+
+        double value = child.score / (2.0 * visits) + _options.exploration * std::sqrt(logParentVisits / visits);
+        if (value > bestValue) {
+            bestValue = value;
+            best = i;
+        }
+    }
+    return best;
+}
+
+void MCTSChessPlayer::runWorker(const Board& rootBoard, uint64_t seed) {
+    RolloutPlayer rollout{seed, _options.captureBias};
+    std::vector<uint32_t> path;
+
+    while (isBudgetLeft()) {
+        Board board{rootBoard};
+        path.assign(1, 0);
+        Node* node = &_nodes[0];
+        node->virtualLoss += _options.virtualLoss;
+
+        while (true) {
+            if (node->state.load(std::memory_order_acquire) != NodeState::EXPANDED) {
+                // Leaves are played out once before they get children, which keeps the tree small
+                if (node->visits == 0 || !expand(*node, board)) break;
+            }
+            if (node->childCount == 0) break;
+
+            uint32_t index = select(*node);
+            node = &_nodes[index];
+            node->virtualLoss += _options.virtualLoss;
+            [[maybe_unused]] bool applied = ChessRules::applyMove(board, *node->move);
+            assert(applied);
+            path.push_back(index);
+        }
+
+        GameResult result = ChessGame::playout(board, rollout, rollout, false, _options.maxPlayoutPlies).result;
+
+        // The side to move at the root played the move into every odd level of the path
+        Color mover = opposite(rootBoard.whosTurnIsIt());
+        for (uint32_t index : path) {
+            Node& pathNode = _nodes[index];
+            pathNode.score += pointsFor(mover, result);
+            pathNode.visits += 1;
+            pathNode.virtualLoss -= _options.virtualLoss;
+            mover = opposite(mover);
+        }
+        ++_playouts;
+    }
+}
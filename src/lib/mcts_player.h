@@ -0,0 +1,70 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "chess_player.h"
+
+/**
+ * @brief Budget and tuning of the Monte Carlo tree search, see MCTSChessPlayer
+ *
+ * At least one of playouts and moveTime must be set.
+ */
+struct MCTSOptions {
+    uint64_t playouts = 10000;              ///< Playouts per move, 0 for no limit
+    std::chrono::milliseconds moveTime{0};  ///< Time per move, 0 for no limit
+    unsigned threads = 1;
+    uint32_t treeSize = 1 << 18;     ///< Capacity of the node arena, the tree stops growing when it is full
+    uint32_t maxPlayoutPlies = 200;  ///< Longer playouts are stopped and count as draw
+    double exploration = 1.4;        ///< UCT exploration constant
+    uint32_t virtualLoss = 3;        ///< Visits added to the nodes a thread currently plays out from
+    double captureBias = 0.5;        ///< Probability that a playout plays a capture if it has one
+};
+
+/**
+ * @brief Picks moves by Monte Carlo tree search with UCT selection and random playouts
+ *
+ * All nodes live in one preallocated arena and refer to their children by index. A node gets its children
+ * on its second visit, all at once and in a consecutive block. Threads share the tree and use virtual loss
+ * to spread over different lines. The tree is built from scratch for every move.
+ */
+class MCTSChessPlayer : public ChessPlayer {
+   public:
+    MCTSChessPlayer(const std::string& name, const MCTSOptions& options = {});
+    MCTSChessPlayer(const std::string& name, const MCTSOptions& options, uint64_t seed);
+    ~MCTSChessPlayer();
+
+    Move getMove(const Board& board, const std::vector<Move>& potentialMoves) override;
+    void seed(uint64_t seed) override { _random.seed(seed); }
+
+    /**
+     * @brief Number of playouts of the last search
+     */
+    uint64_t getPlayouts() const;
+
+    /**
+     * @brief Number of nodes the tree of the last search had
+     */
+    uint32_t getNodes() const;
+
+   private:
+    struct Node;
+
+    bool expand(Node& node, const Board& board);
+    uint32_t select(const Node& node) const;
+    void runWorker(const Board& board, uint64_t seed);
+    bool isBudgetLeft();
+
+    MCTSOptions _options;
+    std::mt19937_64 _random;
+    std::unique_ptr<Node[]> _nodes;
+    std::atomic<uint32_t> _nodeCount{0};
+    std::atomic<bool> _treeFull{false};
+    std::atomic<uint64_t> _startedPlayouts{0};
+    std::atomic<uint64_t> _playouts{0};
+    std::chrono::steady_clock::time_point _startTime;
+};
@@ -1,16 +1,29 @@
 #include "move.h"
 
-#include <base/improve_containers.h>
+static constexpr uint16_t modifierBit(MoveModifier mod) { return static_cast<uint16_t>(1u << static_cast<int>(mod)); }
 
-Move::Move(ChessPiece piece, ChessField start, ChessField end, std::set<MoveModifier>&& mods)
-    : _piece(piece), _startField(start), _endField(end), _mods(mods) {}
-Move::Move(ChessPiece piece, ChessFile startLine, ChessRank startRow, ChessFile endLine, ChessRank endRow, std::set<MoveModifier>&& mods)
-    : _piece(piece), _startField{startLine, startRow}, _endField{endLine, endRow}, _mods(mods) {}
+static uint16_t modifierBits(std::initializer_list<MoveModifier> mods) {
+    uint16_t bits = 0;
+    for (MoveModifier mod : mods) bits |= modifierBit(mod);
+    return bits;
+}
 
-void Move::addModifier(MoveModifier mod) { _mods.insert(mod); }
-void Move::clearModifiers() { _mods.clear(); }
-std::set<MoveModifier> Move::getModifiers() const { return _mods; }
-bool Move::hasModifier(MoveModifier mod) const { return base::find(_mods, mod) != _mods.end(); }
+Move::Move(ChessPiece piece, ChessField start, ChessField end, std::initializer_list<MoveModifier> mods)
+    : _piece(piece), _startField(start), _endField(end), _mods(modifierBits(mods)) {}
+Move::Move(ChessPiece piece, ChessFile startLine, ChessRank startRow, ChessFile endLine, ChessRank endRow,
+           std::initializer_list<MoveModifier> mods)
+    : _piece(piece), _startField(startLine, startRow), _endField(endLine, endRow), _mods(modifierBits(mods)) {}
+
+void Move::addModifier(MoveModifier mod) { _mods |= modifierBit(mod); }
+void Move::clearModifiers() { _mods = 0; }
+std::set<MoveModifier> Move::getModifiers() const {
+    std::set<MoveModifier> mods;
+    for (int i = 0; i <= static_cast<int>(MoveModifier::PROMOTE_KNIGHT); ++i) {
+        if (hasModifier(static_cast<MoveModifier>(i))) mods.insert(static_cast<MoveModifier>(i));
+    }
+    return mods;
+}
+bool Move::hasModifier(MoveModifier mod) const { return (_mods & modifierBit(mod)) != 0; }
 
 ChessPiece Move::getChessPiece() const { return _piece; }
 ChessField Move::getStartField() const { return _startField; }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+#include <initializer_list>
 #include <set>
 
 #include "types.h"
@@ -20,9 +22,9 @@ enum class MoveModifier {
 
 class Move {
    public:
-    Move(ChessPiece piece, ChessField start, ChessField end, std::set<MoveModifier>&& mods = {});
+    Move(ChessPiece piece, ChessField start, ChessField end, std::initializer_list<MoveModifier> mods = {});
     Move(ChessPiece piece, ChessFile startLine, ChessRank startRow, ChessFile endLine, ChessRank endRow,
-         std::set<MoveModifier>&& mods = {});
+         std::initializer_list<MoveModifier> mods = {});
 
     bool operator==(const Move& other) const = default;
 
@@ -35,10 +37,15 @@ class Move {
     ChessField getStartField() const;
     ChessField getEndField() const;
 
+    PieceCode getPieceCode() const { return _piece; }
+    Square getStartSquare() const { return _startField; }
+    Square getEndSquare() const { return _endField; }
+
    private:
-    ChessPiece _piece;
-    ChessField _startField;
-    ChessField _endField;
+    PieceCode _piece;
+    Square _startField;
+    Square _endField;
 
-    std::set<MoveModifier> _mods;
+    // One bit per MoveModifier, so moves can be copied and stored without any allocation
+    uint16_t _mods = 0;
 };
@@ -0,0 +1,111 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "move.h"
+
+/**
+ * @brief List of moves with inline storage for the most moves a chess position can have
+ *
+ * No position has more than 218 legal moves, so 256 slots are enough for every generator and the list
+ * never touches the heap. It lives on the stack of the caller, which passes it to the generators to be
+ * appended to.
+ */
+class MoveList {
+   public:
+    static constexpr size_t Capacity = 256;
+
+    using value_type = Move;
+    using iterator = Move*;
+    using const_iterator = const Move*;
+
+    MoveList() = default;
+    MoveList(const MoveList& other) { append(other.begin(), other.end()); }
+    MoveList& operator=(const MoveList& other) {
+        if (this != &other) {
+            clear();
+            append(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    void push_back(const Move& move) {
+        assert(_size < Capacity);
+        new (data() + _size) Move(move);
+        ++_size;
+    }
+
+    template <typename... Args>
+    Move& emplace_back(Args&&... args) {
+        assert(_size < Capacity);
+        Move* move = new (data() + _size) Move(std::forward<Args>(args)...);
+        ++_size;
+        return *move;
+    }
+
+    template <typename Iter>
+    void append(Iter first, Iter last) {
+        for (; first != last; ++first) push_back(*first);
+    }
+
+    void pop_back() {
+        assert(_size > 0);
+        --_size;
+    }
+
+    /**
+     * @brief Drops all moves behind the first size ones
+     */
+    void truncate(size_t size) {
+        assert(size <= _size);
+        _size = size;
+    }
+
+    /**
+     * @brief Removes all moves the predicate is true for, keeping the order of the others
+     */
+    template <typename Predicate>
+    void erase_if(Predicate predicate) {
+        size_t kept = 0;
+        for (size_t i = 0; i < _size; ++i) {
+            if (predicate(data()[i])) continue;
+            if (kept != i) data()[kept] = data()[i];
+            ++kept;
+        }
+        _size = kept;
+    }
+
+    void clear() { _size = 0; }
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+
+    Move& operator[](size_t index) {
+        assert(index < _size);
+        return data()[index];
+    }
+    const Move& operator[](size_t index) const {
+        assert(index < _size);
+        return data()[index];
+    }
+
+    iterator begin() { return data(); }
+    iterator end() { return data() + _size; }
+    const_iterator begin() const { return data(); }
+    const_iterator end() const { return data() + _size; }
+
+    std::vector<Move> toVector() const { return std::vector<Move>(begin(), end()); }
+
+   private:
+    // Moves are never destroyed explicitly, which is only fine as long as they own nothing
+    static_assert(std::is_trivially_destructible_v<Move>);
+
+    Move* data() { return std::launder(reinterpret_cast<Move*>(_storage)); }
+    const Move* data() const { return std::launder(reinterpret_cast<const Move*>(_storage)); }
+
+    alignas(Move) unsigned char _storage[Capacity * sizeof(Move)];
+    size_t _size = 0;
+};
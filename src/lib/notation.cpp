@@ -0,0 +1,181 @@
+#include "notation.h"
+
+#include "move_list.h"
+#include "rules.h"
+
+static std::optional<Piece> pieceFromSANChar(char c) {
+    switch (c) {
+        case 'N':
+            return Piece::KNIGHT;
+        case 'B':
+            return Piece::BISHOP;
+        case 'R':
+            return Piece::ROOK;
+        case 'Q':
+            return Piece::QUEEN;
+        case 'K':
+            return Piece::KING;
+        default:
+            return std::nullopt;
+    }
+}
+
+static std::optional<MoveModifier> promotionFromSANChar(char c) {
+    switch (c) {
+        case 'N':
+        case 'n':
+            return MoveModifier::PROMOTE_KNIGHT;
+        case 'B':
+        case 'b':
+            return MoveModifier::PROMOTE_BISHOP;
+        case 'R':
+        case 'r':
+            return MoveModifier::PROMOTE_ROOK;
+        case 'Q':
+        case 'q':
+            return MoveModifier::PROMOTE_QUEEN;
+        default:
+            return std::nullopt;
+    }
+}
+
+static bool isFileChar(char c) { return c >= 'a' && c <= 'h'; }
+static bool isRankChar(char c) { return c >= '1' && c <= '8'; }
+
+static bool isPromotion(const Move& move) {
+    return move.hasModifier(MoveModifier::PROMOTE_QUEEN) || move.hasModifier(MoveModifier::PROMOTE_ROOK) ||
+           move.hasModifier(MoveModifier::PROMOTE_BISHOP) || move.hasModifier(MoveModifier::PROMOTE_KNIGHT);
+}
+
+std::optional<Move> Notation::parseSAN(const Board& board, std::string_view san) {
+    return parseSAN(board, san, ChessRules::getAllValidMoves(board, false));
+}
+
+std::optional<Move> Notation::parseSAN(const Board&, std::string_view san, const std::vector<Move>& validMoves) {
+    while (!san.empty() && (san.back() == '+' || san.back() == '#' || san.back() == '!' || san.back() == '?')) san.remove_suffix(1);
+    if (san.empty()) return std::nullopt;
+
+    if (san == "O-O" || san == "0-0" || san == "O-O-O" || san == "0-0-0") {
+        MoveModifier castling = (san.size() == 3 ? MoveModifier::CASTLING_SHORT : MoveModifier::CASTLING_LONG);
+        for (const Move& move : validMoves) {
+            if (move.hasModifier(castling)) return move;
+        }
+        return std::nullopt;
+    }
+
+    Piece piece = Piece::PAWN;
+    if (auto sanPiece = pieceFromSANChar(san.front())) {
+        piece = *sanPiece;
+        san.remove_prefix(1);
+    }
+
+    std::optional<MoveModifier> promotion;
+    if (san.size() > 2 && !isRankChar(san.back())) {
+        promotion = promotionFromSANChar(san.back());
+        if (!promotion) return std::nullopt;
+        san.remove_suffix(1);
+        if (san.back() == '=') san.remove_suffix(1);
+    }
+
+    if (san.size() < 2 || !isFileChar(san[san.size() - 2]) || !isRankChar(san.back())) return std::nullopt;
+    ChessField endField{san[san.size() - 2] - 'a' + A, san.back() - '0'};
+    san.remove_suffix(2);
+
+    // Whatever is left is disambiguation, optionally followed by a capture or a long SAN dash
+    std::optional<ChessFile> fromFile;
+    std::optional<ChessRank> fromRank;
+    for (char c : san) {
+        if (isFileChar(c))
+            fromFile = c - 'a' + A;
+        else if (isRankChar(c))
+            fromRank = c - '0';
+        else if (c != 'x' && c != ':' && c != '-')
+            return std::nullopt;
+    }
+
+    std::optional<Move> found;
+    for (const Move& move : validMoves) {
+        if (std::get<PieceIdx>(move.getChessPiece()) != piece || move.getEndField() != endField) continue;
+        if (fromFile && std::get<ChessFileIdx>(move.getStartField()) != *fromFile) continue;
+        if (fromRank && std::get<ChessRankIdx>(move.getStartField()) != *fromRank) continue;
+        if (promotion ? !move.hasModifier(*promotion) : isPromotion(move)) continue;
+        if (found) return std::nullopt;
+        found = move;
+    }
+    return found;
+}
+
+static char sanCharFromPiece(Piece piece) {
+    switch (piece) {
+        case Piece::KNIGHT:
+            return 'N';
+        case Piece::BISHOP:
+            return 'B';
+        case Piece::ROOK:
+            return 'R';
+        case Piece::QUEEN:
+            return 'Q';
+        case Piece::KING:
+            return 'K';
+        default:
+            return '?';
+    }
+}
+
+static void appendField(fmt::memory_buffer& out, ChessField field) {
+    out.push_back(static_cast<char>('a' + std::get<ChessFileIdx>(field) - A));
+    out.push_back(static_cast<char>('0' + std::get<ChessRankIdx>(field)));
+}
+
+std::string Notation::toSAN(const Board& board, const Move& move) {
+    Board boardAfterMove(board);
+    ChessRules::applyMove(boardAfterMove, move);
+    fmt::memory_buffer out;
+    MoveList validMoves;
+    ChessRules::getAllValidMoves(board, validMoves, false);
+    appendSAN(out, board, move, validMoves, boardAfterMove);
+    return fmt::to_string(out);
+}
+
+void Notation::appendSAN(fmt::memory_buffer& out, const Board&, const Move& move, std::span<const Move> validMoves,
+                         const Board& boardAfterMove) {
+    Piece piece = std::get<PieceIdx>(move.getChessPiece());
+    ChessField start = move.getStartField();
+    bool capture = move.hasModifier(MoveModifier::CAPTURE) || move.hasModifier(MoveModifier::EN_PASSANT);
+
+    if (move.hasModifier(MoveModifier::CASTLING_SHORT)) {
+        fmt::format_to(std::back_inserter(out), "O-O");
+    } else if (move.hasModifier(MoveModifier::CASTLING_LONG)) {
+        fmt::format_to(std::back_inserter(out), "O-O-O");
+    } else if (piece == Piece::PAWN) {
+        if (capture) {
+            out.push_back(static_cast<char>('a' + std::get<ChessFileIdx>(start) - A));
+            out.push_back('x');
+        }
+        appendField(out, move.getEndField());
+        if (move.hasModifier(MoveModifier::PROMOTE_QUEEN)) fmt::format_to(std::back_inserter(out), "=Q");
+        if (move.hasModifier(MoveModifier::PROMOTE_ROOK)) fmt::format_to(std::back_inserter(out), "=R");
+        if (move.hasModifier(MoveModifier::PROMOTE_BISHOP)) fmt::format_to(std::back_inserter(out), "=B");
+        if (move.hasModifier(MoveModifier::PROMOTE_KNIGHT)) fmt::format_to(std::back_inserter(out), "=N");
+    } else {
+        out.push_back(sanCharFromPiece(piece));
+
+        // Disambiguate by file if that is unique, else by rank if that is unique, else by both
+        bool ambiguous = false, sameFile = false, sameRank = false;
+        for (const Move& other : validMoves) {
+            if (std::get<PieceIdx>(other.getChessPiece()) != piece || other.getEndField() != move.getEndField() ||
+                other.getStartField() == start)
+                continue;
+            ambiguous = true;
+            sameFile |= std::get<ChessFileIdx>(other.getStartField()) == std::get<ChessFileIdx>(start);
+            sameRank |= std::get<ChessRankIdx>(other.getStartField()) == std::get<ChessRankIdx>(start);
+        }
+        if (ambiguous && (!sameFile || sameRank)) out.push_back(static_cast<char>('a' + std::get<ChessFileIdx>(start) - A));
+        if (ambiguous && sameFile) out.push_back(static_cast<char>('0' + std::get<ChessRankIdx>(start)));
+
+        if (capture) out.push_back('x');
+        appendField(out, move.getEndField());
+    }
+
+    if (ChessRules::isCheck(boardAfterMove)) out.push_back(ChessRules::hasValidMove(boardAfterMove) ? '+' : '#');
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <fmt/format.h>
+
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "board.h"
+#include "move.h"
+
+/**
+ * @brief Conversion of moves from and to Standard Algebraic Notation (SAN) as used in PGN
+ */
+class Notation {
+   public:
+    /**
+     * @brief Find the valid move on the board that is described by a SAN string
+     *
+     * Accepts the usual variants found in the wild: castling with O or 0, check/mate and annotation
+     * suffixes (+ # ! ?), promotions with or without '=' and superfluous disambiguation.
+     *
+     * @param board  The board the move is played on
+     * @param san    The move in SAN, e.g. "Nbd7", "exd5", "e8=Q+" or "O-O"
+     * @return std::optional<Move> The move or nothing in case it is invalid or ambiguous
+     */
+    static std::optional<Move> parseSAN(const Board& board, std::string_view san);
+
+    /**
+     * @brief Same as above but matches against the already known valid moves of the board
+     */
+    static std::optional<Move> parseSAN(const Board& board, std::string_view san, const std::vector<Move>& validMoves);
+
+    /**
+     * @brief Describe a valid move in SAN, with the minimal disambiguation and a check (+) or mate (#) suffix
+     *
+     * @param board  The board the move is played on
+     * @param move   A valid move on that board
+     * @return std::string The move in SAN, e.g. "Nbd7" or "exd8=Q#"
+     */
+    static std::string toSAN(const Board& board, const Move& move);
+
+    /**
+     * @brief Append the SAN of a move to a buffer, for callers that already know the valid moves and the
+     *        board after the move. The valid moves may come from a std::vector or a MoveList.
+     */
+    static void appendSAN(fmt::memory_buffer& out, const Board& board, const Move& move, std::span<const Move> validMoves,
+                          const Board& boardAfterMove);
+};
@@ -0,0 +1,99 @@
+#include "opening_book.h"
+
+#include "rules.h"
+#include "zobrist.h"
+
+static uint64_t readBigEndian(const char* data, int bytes) {
+    uint64_t value = 0;
+    for (int i = 0; i < bytes; ++i) value = (value << 8) | static_cast<unsigned char>(data[i]);
+    return value;
+}
+
+static int promotionCode(const Move& move) {
+    if (move.hasModifier(MoveModifier::PROMOTE_KNIGHT)) return 1;
+    if (move.hasModifier(MoveModifier::PROMOTE_BISHOP)) return 2;
+    if (move.hasModifier(MoveModifier::PROMOTE_ROOK)) return 3;
+    if (move.hasModifier(MoveModifier::PROMOTE_QUEEN)) return 4;
+    return 0;
+}
+
+PolyglotBook::PolyglotBook(const std::string& path) { open(path); }
+
+bool PolyglotBook::open(const std::string& path) {
+    if (!_file.open(path)) return false;
+    if (_file.size() % EntrySize != 0) {
+        _file.close();
+        return false;
+    }
+    _file.adviseAccess(MappedFile::Access::RANDOM);
+    return true;
+}
+
+void PolyglotBook::close() { _file.close(); }
+
+bool PolyglotBook::isOpen() const { return _file.isOpen(); }
+
+size_t PolyglotBook::size() const { return _file.size() / EntrySize; }
+
+uint16_t PolyglotBook::encodeMove(const Move& move) {
+    ChessField start = move.getStartField();
+    ChessField end = move.getEndField();
+    if (move.hasModifier(MoveModifier::CASTLING_SHORT)) end = ChessField{H, std::get<ChessRankIdx>(start)};
+    if (move.hasModifier(MoveModifier::CASTLING_LONG)) end = ChessField{A, std::get<ChessRankIdx>(start)};
+
+    return static_cast<uint16_t>((std::get<ChessFileIdx>(end) - A) | ((std::get<ChessRankIdx>(end) - 1) << 3) |
+                                 ((std::get<ChessFileIdx>(start) - A) << 6) | ((std::get<ChessRankIdx>(start) - 1) << 9) |
+                                 (promotionCode(move) << 12));
+}
+
+std::vector<BookEntry> PolyglotBook::getEntries(const Board& board) const {
+    std::vector<BookEntry> entries;
+    if (size() == 0) return entries;
+
+    uint64_t key = Zobrist::hash(board);
+
+    // Binary search for the first entry with the key directly in the mapped file
+    size_t low = 0;
+    size_t high = size();
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (readBigEndian(_file.data() + mid * EntrySize, 8) < key)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    std::vector<Move> validMoves;
+    for (size_t idx = low; idx < size(); ++idx) {
+        const char* record = _file.data() + idx * EntrySize;
+        if (readBigEndian(record, 8) != key) break;
+
+        if (validMoves.empty()) validMoves = ChessRules::getAllValidMoves(board, false);
+        uint16_t bookMove = static_cast<uint16_t>(readBigEndian(record + 8, 2));
+        for (const Move& move : validMoves) {
+            if (encodeMove(move) == bookMove) {
+                auto weight = static_cast<uint16_t>(readBigEndian(record + 10, 2));
+                auto learn = static_cast<uint32_t>(readBigEndian(record + 12, 4));
+                entries.push_back({move, weight, learn});
+                break;
+            }
+        }
+    }
+    return entries;
+}
+
+std::optional<Move> PolyglotBook::pickMove(const Board& board, uint64_t random) const {
+    auto entries = getEntries(board);
+    if (entries.empty()) return std::nullopt;
+
+    uint64_t totalWeight = 0;
+    for (const auto& entry : entries) totalWeight += entry.weight;
+    if (totalWeight == 0) return entries[random % entries.size()].move;
+
+    uint64_t pick = random % totalWeight;
+    for (const auto& entry : entries) {
+        if (pick < entry.weight) return entry.move;
+        pick -= entry.weight;
+    }
+    return entries.back().move;
+}
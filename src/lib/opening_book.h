@@ -0,0 +1,70 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "base/helpers.h"
+#include "board.h"
+#include "mapped_file.h"
+#include "move.h"
+
+/**
+ * @brief A move stored in an opening book with its weight
+ */
+struct BookEntry {
+    Move move;
+    uint16_t weight;
+    uint32_t learn;
+};
+
+/**
+ * @brief Opening book in Polyglot .bin format
+ *
+ * The file is a sorted array of 16 byte big-endian records (key, move, weight, learn). It is memory
+ * mapped and binary searched in place, so opening even a multi-GB book takes no time and memory.
+ * Positions are looked up by their Zobrist key (see Zobrist::hash).
+ */
+class PolyglotBook : base::NONCOPYABLE {
+   public:
+    static constexpr size_t EntrySize = 16;
+
+    PolyglotBook() = default;
+    explicit PolyglotBook(const std::string& path);
+
+    /**
+     * @brief Map a book file
+     *
+     * @return bool - Is the file a readable book?
+     */
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const;
+
+    /**
+     * @brief Number of entries in the book
+     */
+    size_t size() const;
+
+    /**
+     * @brief All book moves that are valid on the board, in the order stored in the book
+     */
+    std::vector<BookEntry> getEntries(const Board& board) const;
+
+    /**
+     * @brief Pick one of the book moves, each one with a probability proportional to its weight
+     *
+     * @param board   The board to find a move for
+     * @param random  A random number, the caller decides about the random generator
+     * @return std::optional<Move> Book move or nothing in case the position is not in the book
+     */
+    std::optional<Move> pickMove(const Board& board, uint64_t random) const;
+
+    /**
+     * @brief Encode a move like Polyglot does. Castling is encoded as king captures own rook.
+     */
+    static uint16_t encodeMove(const Move& move);
+
+   private:
+    MappedFile _file;
+};
@@ -0,0 +1,82 @@
+#include "packed_position.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
+#include "board.h"
+
+static constexpr int CastlingOrder[] = {static_cast<int>(Board::Castling::WHITE_SHORT), static_cast<int>(Board::Castling::WHITE_LONG),
+                                        static_cast<int>(Board::Castling::BLACK_SHORT), static_cast<int>(Board::Castling::BLACK_LONG)};
+static constexpr uint8_t NoEnPassant = 0xFF;
+static constexpr int PieceTypes = 6;
+
+static int packedIndex(ChessField field) { return (std::get<ChessRankIdx>(field) - 1) * 8 + (std::get<ChessFileIdx>(field) - A); }
+static ChessField fieldFromPackedIndex(int index) { return ChessField{index % 8 + A, index / 8 + 1}; }
+
+std::optional<PackedPosition> PackedPosition::pack(const Board& board) {
+    PackedPosition packed;
+    uint8_t* bytes = packed.bytes.data();
+
+    uint64_t occupancy = 0;
+    size_t pieces = 0;
+    for (int index = 0; index < 64; ++index) {
+        std::optional<ChessPiece> piece = board.getPieceOnField(fieldFromPackedIndex(index));
+        if (!piece) continue;
+        if (pieces == MaxPieces || std::get<PieceIdx>(*piece) == Piece::DECOY) return std::nullopt;
+
+        uint8_t code = static_cast<uint8_t>(static_cast<int>(std::get<PieceIdx>(*piece)) +
+                                            (std::get<ColorIdx>(*piece) == Color::BLACK ? PieceTypes : 0));
+        bytes[8 + pieces / 2] |= (pieces % 2 == 0 ? code : code << 4);
+        occupancy |= uint64_t{1} << index;
+        ++pieces;
+    }
+    for (int i = 0; i < 8; ++i) bytes[i] = static_cast<uint8_t>(occupancy >> (8 * i));
+
+    uint8_t state = (board.whosTurnIsIt() == Color::BLACK ? 1 : 0);
+    for (int i = 0; i < 4; ++i) {
+        if (board.canCastle(static_cast<Board::Castling>(CastlingOrder[i]))) state |= 1 << (i + 1);
+    }
+    bytes[24] = state;
+    bytes[25] = (board.hasEnPassantTarget() ? static_cast<uint8_t>(packedIndex(*board.getEnPassantTarget())) : NoEnPassant);
+    bytes[26] = static_cast<uint8_t>(std::min<uint32_t>(board.getHalfMoveClock(), UINT8_MAX));
+    uint16_t fullMoves = static_cast<uint16_t>(std::min<uint32_t>(board.getFullMoves(), UINT16_MAX));
+    bytes[27] = static_cast<uint8_t>(fullMoves);
+    bytes[28] = static_cast<uint8_t>(fullMoves >> 8);
+
+    return packed;
+}
+
+bool PackedPosition::unpack(const uint8_t* bytes, Board& board) {
+    uint64_t occupancy = 0;
+    for (int i = 0; i < 8; ++i) occupancy |= uint64_t{bytes[i]} << (8 * i);
+    if (std::popcount(occupancy) > static_cast<int>(MaxPieces) || (bytes[24] >> 5) != 0) return false;
+    if (bytes[25] != NoEnPassant && bytes[25] >= 64) return false;
+
+    Board unpacked;
+    size_t pieces = 0;
+    for (uint64_t remaining = occupancy; remaining != 0; remaining &= remaining - 1, ++pieces) {
+        int code = (bytes[8 + pieces / 2] >> (pieces % 2 == 0 ? 0 : 4)) & 0x0F;
+        if (code >= 2 * PieceTypes) return false;
+        ChessPiece piece{code < PieceTypes ? Color::WHITE : Color::BLACK, static_cast<Piece>(code % PieceTypes)};
+        unpacked._board[BoardHelper::fieldToIndex(fieldFromPackedIndex(std::countr_zero(remaining)))] = piece;
+    }
+
+    unpacked._whosTurn = (bytes[24] & 1 ? Color::BLACK : Color::WHITE);
+    for (int i = 0; i < 4; ++i) {
+        if (bytes[24] & (1 << (i + 1))) unpacked.setCastling(static_cast<Board::Castling>(CastlingOrder[i]));
+    }
+    if (bytes[25] != NoEnPassant) unpacked._enpassantTarget = fieldFromPackedIndex(bytes[25]);
+    unpacked._halfmoveClock = bytes[26];
+    unpacked._fullMoves = bytes[27] | (bytes[28] << 8);
+
+    board = unpacked;
+    return true;
+}
+
+Board PackedPosition::unpack() const {
+    Board board;
+    [[maybe_unused]] bool valid = unpack(bytes.data(), board);
+    assert(valid);
+    return board;
+}
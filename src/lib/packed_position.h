@@ -0,0 +1,52 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+class Board;
+
+/**
+ * @brief A board packed into 32 bytes for bulk storage
+ *
+ * Layout (multi-byte values little-endian):
+ * - bytes  0-7   occupancy, bit (rank - 1) * 8 + (file - 1) is set for every occupied field
+ * - bytes  8-23  one 4-bit piece code per occupied field in occupancy bit order, low nibble first.
+ *                Codes 0-5 are the white pawn, rook, knight, bishop, queen and king, 6-11 the black ones
+ * - byte  24     bit 0 black to move, bits 1-4 castling rights white short, white long, black short, black long
+ * - byte  25     en-passant target as field index like in the occupancy, 0xFF for none
+ * - byte  26     halfmove clock, saturated at 255
+ * - bytes 27-28  fullmove number, saturated at 65535
+ * - bytes 29-31  reserved, zero
+ *
+ * Boards with more than 32 pieces can not be packed.
+ */
+struct PackedPosition {
+    static constexpr size_t Size = 32;
+    static constexpr size_t MaxPieces = 32;
+
+    std::array<uint8_t, Size> bytes{};
+
+    bool operator==(const PackedPosition& other) const = default;
+
+    /**
+     * @brief Pack a board
+     *
+     * @return std::optional<PackedPosition> The packed board or nothing if it has too many pieces
+     */
+    static std::optional<PackedPosition> pack(const Board& board);
+
+    /**
+     * @brief Unpack a position from raw bytes, e.g. straight from a memory mapped file
+     *
+     * @param data   Size bytes of a packed position
+     * @param board  Receives the position. It is only changed if the data is valid.
+     * @return bool - Was the data a valid packed position?
+     */
+    static bool unpack(const uint8_t* data, Board& board);
+
+    /**
+     * @brief Unpack this position
+     */
+    Board unpack() const;
+};
@@ -0,0 +1,245 @@
+#include "pgn.h"
+
+#include <algorithm>
+
+#include "board_factory.h"
+#include "fen.h"
+#include "move_list.h"
+#include "notation.h"
+#include "rules.h"
+
+static bool isSpace(char c) { return c == ' ' || c == '\n' || c == '\r' || c == '\t'; }
+static bool isDigit(char c) { return c >= '0' && c <= '9'; }
+static bool isTokenEnd(char c) { return isSpace(c) || c == '{' || c == '(' || c == ')' || c == ';' || c == '['; }
+static bool isResult(std::string_view token) { return token == "1-0" || token == "0-1" || token == "1/2-1/2" || token == "*"; }
+
+std::optional<std::string_view> PgnGame::getTag(std::string_view name) const {
+    for (const PgnTag& tag : tags) {
+        if (tag.name == name) return tag.value;
+    }
+    return std::nullopt;
+}
+
+void PgnGame::clear() {
+    tags.clear();
+    sanMoves.clear();
+    moves.clear();
+    result = {};
+    invalidMove.reset();
+}
+
+PgnReader::PgnReader(std::string_view text) : _pos(text.data()), _end(text.data() + text.size()) {}
+
+bool PgnReader::open(const std::string& path) {
+    if (!_file.open(path)) return false;
+    _file.adviseAccess(MappedFile::Access::SEQUENTIAL);
+    _pos = _file.data();
+    _end = _file.data() + _file.size();
+    return true;
+}
+
+void PgnReader::setResolvePlies(size_t plies) { _resolvePlies = plies; }
+
+void PgnReader::skipLine() {
+    while (_pos != _end && *_pos != '\n') ++_pos;
+}
+
+void PgnReader::skipPast(char c) {
+    while (_pos != _end && *_pos++ != c) {
+    }
+}
+
+void PgnReader::readTag(PgnGame& game) {
+    // _pos is behind the '['
+    const char* nameStart = _pos;
+    while (_pos != _end && !isSpace(*_pos) && *_pos != ']' && *_pos != '"') ++_pos;
+    std::string_view name(nameStart, _pos - nameStart);
+    while (_pos != _end && isSpace(*_pos)) ++_pos;
+
+    if (_pos != _end && *_pos == '"') {
+        const char* valueStart = ++_pos;
+        while (_pos != _end && *_pos != '"') _pos += (*_pos == '\\' && _pos + 1 != _end ? 2 : 1);
+        if (!name.empty()) game.tags.push_back({name, std::string_view(valueStart, _pos - valueStart)});
+    }
+    skipPast(']');
+}
+
+std::string_view PgnReader::readToken() {
+    const char* start = _pos;
+    while (_pos != _end && !isTokenEnd(*_pos)) ++_pos;
+    return std::string_view(start, _pos - start);
+}
+
+bool PgnReader::readGame(PgnGame& game) {
+    game.clear();
+    bool inMovetext = false;
+    int variationDepth = 0;
+
+    while (_pos != _end) {
+        char c = *_pos;
+        if (isSpace(c)) {
+            ++_pos;
+        } else if (c == '[') {
+            // A tag after the movetext starts the next game, the result of this one is missing
+            if (inMovetext && variationDepth == 0) break;
+            ++_pos;
+            readTag(game);
+        } else if (c == '{') {
+            skipPast('}');
+        } else if (c == ';' || (c == '%' && !inMovetext)) {
+            skipLine();
+        } else if (c == '(') {
+            ++_pos;
+            ++variationDepth;
+        } else if (c == ')') {
+            ++_pos;
+            if (variationDepth > 0) --variationDepth;
+        } else {
+            inMovetext = true;
+            std::string_view token = readToken();
+            if (token.empty()) {
+                ++_pos;
+                continue;
+            }
+            if (variationDepth > 0 || token.front() == '$') continue;
+            if (isResult(token)) {
+                game.result = token;
+                break;
+            }
+            // Strip move numbers like "12." or "12..." which may be glued to the move
+            size_t moveStart = 0;
+            while (moveStart < token.size() && (isDigit(token[moveStart]) || token[moveStart] == '.')) ++moveStart;
+            if (moveStart > 0 && moveStart < token.size() && token[moveStart - 1] != '.') moveStart = 0;
+            if (moveStart < token.size()) game.sanMoves.push_back(token.substr(moveStart));
+        }
+    }
+
+    if (!inMovetext && game.tags.empty()) return false;
+    resolveMoves(game);
+    return true;
+}
+
+void PgnReader::resolveMoves(PgnGame& game) const {
+    if (_resolvePlies == 0) return;
+
+    Board board = BoardFactory::createStandardBoard();
+    std::optional<std::string_view> fen = game.getTag("FEN");
+    if (fen && !Fen::parse(*fen, board)) {
+        game.invalidMove = 0;
+        return;
+    }
+    size_t plies = std::min(_resolvePlies, game.sanMoves.size());
+    for (size_t ply = 0; ply < plies; ++ply) {
+        std::optional<Move> move = Notation::parseSAN(board, game.sanMoves[ply]);
+        if (!move) {
+            game.invalidMove = ply;
+            return;
+        }
+        game.moves.push_back(*move);
+        ChessRules::applyMove(board, *move);
+    }
+}
+
+PgnReader::iterator::iterator(PgnReader* reader) : _reader(reader) { ++*this; }
+
+PgnReader::iterator& PgnReader::iterator::operator++() {
+    if (!_reader->readGame(_reader->_game)) _reader = nullptr;
+    return *this;
+}
+
+static constexpr size_t MaxLineLength = 79;
+
+std::string_view PgnWriter::getResult(const Board& board) {
+    GameStatus status = ChessRules::evaluateStatus(board);
+    if (status == GameStatus::CHECK_MATE) return board.whosTurnIsIt() == Color::WHITE ? "0-1" : "1-0";
+    if (status != GameStatus::ONGOING) return "1/2-1/2";
+    return "*";
+}
+
+std::string_view PgnWriter::getResult(GameResult result) {
+    switch (result) {
+        case GameResult::WHITE_WINS:
+            return "1-0";
+        case GameResult::BLACK_WINS:
+            return "0-1";
+        case GameResult::DRAW:
+            return "1/2-1/2";
+        case GameResult::UNDECIDED:
+            break;
+    }
+    return "*";
+}
+
+void PgnWriter::writeTag(std::string_view name, std::string_view value) {
+    fmt::format_to(std::back_inserter(_buffer), "[{} \"", name);
+    for (char c : value) {
+        if (c == '"' || c == '\\') _buffer.push_back('\\');
+        _buffer.push_back(c);
+    }
+    fmt::format_to(std::back_inserter(_buffer), "\"]\n");
+}
+
+void PgnWriter::writeToken(std::string_view token) {
+    if (_buffer.size() > _lineStart) {
+        if (_buffer.size() - _lineStart + 1 + token.size() > MaxLineLength) {
+            _buffer.push_back('\n');
+            _lineStart = _buffer.size();
+        } else {
+            _buffer.push_back(' ');
+        }
+    }
+    _buffer.append(token.data(), token.data() + token.size());
+}
+
+void PgnWriter::writeGame(const ChessGameProgress& progress, const PgnGameInfo& info) {
+    const Board& root = *progress.begin()->content;
+    std::string_view result = (info.result ? std::string_view(*info.result) : getResult(*progress.getCurrentState().content));
+
+    writeTag("Event", info.event);
+    writeTag("Site", info.site);
+    writeTag("Date", info.date);
+    writeTag("Round", info.round);
+    writeTag("White", info.white);
+    writeTag("Black", info.black);
+    writeTag("Result", result);
+    if (!(root == BoardFactory::createStandardBoard())) {
+        writeTag("SetUp", "1");
+        Fen::Buffer fenBuffer;
+        writeTag("FEN", Fen::write(root, fenBuffer, true));
+    }
+    _buffer.push_back('\n');
+    _lineStart = _buffer.size();
+
+    // The board's full move counter is 0 for a fresh board, so count on our own
+    uint32_t moveNumber = std::max<uint32_t>(1, root.getFullMoves());
+    fmt::memory_buffer token;
+    MoveList validMoves;
+    for (size_t i = 0; i < progress.getNumberOfMoves(); ++i) {
+        ChessGameProgress::State state = progress.getState(i);
+        const Board& board = *state.content;
+        token.clear();
+        if (board.whosTurnIsIt() == Color::WHITE)
+            fmt::format_to(std::back_inserter(token), "{}.", moveNumber);
+        else if (i == 0)
+            fmt::format_to(std::back_inserter(token), "{}...", moveNumber);
+        if (token.size() > 0) writeToken(std::string_view(token.data(), token.size()));
+
+        token.clear();
+        validMoves.clear();
+        ChessRules::getAllValidMoves(board, validMoves, false);
+        Notation::appendSAN(token, board, *state.moveToNext, validMoves, *progress.getState(i + 1).content);
+        writeToken(std::string_view(token.data(), token.size()));
+        if (board.whosTurnIsIt() == Color::BLACK) ++moveNumber;
+    }
+    writeToken(result);
+    _buffer.push_back('\n');
+    _buffer.push_back('\n');
+    _lineStart = _buffer.size();
+}
+
+bool PgnWriter::flush(std::FILE* file) {
+    bool written = std::fwrite(_buffer.data(), 1, _buffer.size(), file) == _buffer.size();
+    clear();
+    _lineStart = 0;
+    return written;
+}
@@ -0,0 +1,182 @@
+#pragma once
+#include <fmt/format.h>
+
+#include <cstdio>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "base/helpers.h"
+#include "chess_game.h"
+#include "mapped_file.h"
+#include "move.h"
+
+/**
+ * @brief A tag pair of a PGN game, e.g. [White "Carlsen, Magnus"]
+ *
+ * Both views point into the buffer of the PgnReader. The value is as written in the file, escape
+ * sequences (\" and \\) are kept.
+ */
+struct PgnTag {
+    std::string_view name;
+    std::string_view value;
+};
+
+/**
+ * @brief One game of a PGN file
+ *
+ * All views point into the buffer of the PgnReader and are valid as long as the reader is. The
+ * vectors are reused from game to game, so reading games does not allocate once they reached
+ * their maximum size.
+ */
+struct PgnGame {
+    std::vector<PgnTag> tags;
+    std::vector<std::string_view> sanMoves;  ///< Moves of the main line as written in the file
+    std::vector<Move> moves;                 ///< The SAN moves resolved against the board, see invalidMove
+    std::string_view result;
+    /// Index of the first SAN move that is not valid on the board. Moves after it are not resolved.
+    std::optional<size_t> invalidMove;
+
+    std::optional<std::string_view> getTag(std::string_view name) const;
+    void clear();
+};
+
+/**
+ * @brief Streaming reader for PGN files
+ *
+ * The file is memory mapped and tokenized in place, tokens are string_views into the mapping. Comments,
+ * NAGs and variations are skipped, only the main line is kept. The SAN moves of every game are resolved
+ * to Moves by replaying them from the start position (or the position of a FEN tag), which is far more
+ * expensive than the parsing itself. Limit it with setResolvePlies if only the opening is of interest.
+ *
+ * Games are read one at a time either via readGame or by iterating over the reader:
+ * @code
+ * PgnReader reader;
+ * reader.open("games.pgn");
+ * for (const PgnGame& game : reader) { ... }
+ * @endcode
+ */
+class PgnReader : base::NONCOPYABLE {
+   public:
+    PgnReader() = default;
+
+    /**
+     * @brief Read from a buffer owned by the caller
+     */
+    explicit PgnReader(std::string_view text);
+
+    /**
+     * @brief Map a PGN file and read from the start of it
+     *
+     * @return bool - Could the file be mapped?
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief Resolve at most the first plies of every game to Moves, 0 to not resolve at all
+     */
+    void setResolvePlies(size_t plies);
+
+    /**
+     * @brief Read the next game
+     *
+     * @param game  Receives the game, reusing its memory
+     * @return bool - Was a game read or is the input at its end?
+     */
+    bool readGame(PgnGame& game);
+
+    class iterator {
+       public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = PgnGame;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const PgnGame*;
+        using reference = const PgnGame&;
+
+        iterator() = default;
+        explicit iterator(PgnReader* reader);
+
+        reference operator*() const { return _reader->_game; }
+        pointer operator->() const { return &_reader->_game; }
+        iterator& operator++();
+        bool operator==(const iterator& other) const { return _reader == other._reader; }
+
+       private:
+        PgnReader* _reader = nullptr;
+    };
+
+    /**
+     * @brief Iterate over the remaining games. The reader holds the current game, so there is only one
+     *        pass and one iterator at a time.
+     */
+    iterator begin() { return iterator(this); }
+    iterator end() { return iterator(); }
+
+   private:
+    void skipLine();
+    void skipPast(char c);
+    void readTag(PgnGame& game);
+    std::string_view readToken();
+    void resolveMoves(PgnGame& game) const;
+
+    MappedFile _file;
+    const char* _pos = nullptr;
+    const char* _end = nullptr;
+    size_t _resolvePlies = std::numeric_limits<size_t>::max();
+    PgnGame _game;
+};
+
+/**
+ * @brief The Seven Tag Roster of a game. Without a result it is determined from the final position.
+ */
+struct PgnGameInfo {
+    std::string event = "?";
+    std::string site = "?";
+    std::string date = "????.??.??";
+    std::string round = "?";
+    std::string white = "?";
+    std::string black = "?";
+    std::optional<std::string> result = std::nullopt;
+};
+
+/**
+ * @brief Writes games in PGN export format into an in-memory buffer
+ *
+ * Games are appended to a buffer that keeps its memory when it is flushed, so logging lots of games
+ * does not allocate once the buffer grew to the size of a flush.
+ */
+class PgnWriter : base::NONCOPYABLE {
+   public:
+    /**
+     * @brief Append a game with its tags, the moves in SAN and the result
+     */
+    void writeGame(const ChessGameProgress& progress, const PgnGameInfo& info);
+
+    std::string_view getText() const { return std::string_view(_buffer.data(), _buffer.size()); }
+    size_t size() const { return _buffer.size(); }
+    void clear() { _buffer.clear(); }
+
+    /**
+     * @brief Write the buffered text to a file and clear the buffer
+     *
+     * @return bool - Was everything written?
+     */
+    bool flush(std::FILE* file);
+
+    /**
+     * @brief PGN result of the final position of a game: 1-0, 0-1, 1/2-1/2 or * if it is not over
+     */
+    static std::string_view getResult(const Board& board);
+    static std::string_view getResult(GameResult result);
+
+   private:
+    void writeTag(std::string_view name, std::string_view value);
+    void writeToken(std::string_view token);
+
+    fmt::memory_buffer _buffer;
+    size_t _lineStart = 0;
+};
@@ -1,14 +1,22 @@
 #include "piece_rules.h"
 
-#include <base/improve_containers.h>
-
 #include <cassert>
-#include <map>
+#include <vector>
 
 #include "board.h"
+#include "color_traits.h"
 #include "move.h"
+#include "move_list.h"
 #include "types.h"
 
+// The std::vector variants of the piece rules, for callers that do not care about allocations
+template <typename Rules>
+static std::vector<Move> collectPotentialMoves(const Board& board, ChessPieceOnField pieceOnField) {
+    MoveList potentialMoves;
+    Rules::getPotentialMoves(board, pieceOnField, potentialMoves);
+    return potentialMoves.toVector();
+}
+
 /**
  * @brief Adds move to potentitalMoves if field is available and returns whether search can
  *
@@ -19,7 +27,7 @@
  * @return true     In case the field is blocked and the search can be stopped (can also be a capture move)
  * @return false    In case the field is available to be moved to and the search shall continue
  */
-bool addMoveOrIsBlocked(const Board& board, const ChessField& potentialMoveField, std::vector<Move>& potentialMoves,
+bool addMoveOrIsBlocked(const Board& board, const ChessField& potentialMoveField, MoveList& potentialMoves,
                         const ChessPieceOnField& pieceOnField) {
     ChessPiece cp = std::get<ChessPieceIdx>(pieceOnField);
     Color color = std::get<ColorIdx>(cp);
@@ -29,115 +37,101 @@ bool addMoveOrIsBlocked(const Board& board, const ChessField& potentialMoveField
         std::get<ChessRankIdx>(potentialMoveField) < 1 || std::get<ChessRankIdx>(potentialMoveField) > 8)
         return true;
 
-    auto pieceOnMoveField = board.getPieceOnField(potentialMoveField);
+    PieceCode pieceOnMoveField = board.getPieceCode(potentialMoveField);
 
     if (!pieceOnMoveField) {
         potentialMoves.emplace_back(cp, currentField, potentialMoveField);
-    } else if (std::get<ColorIdx>(*pieceOnMoveField) == color) {
+    } else if (pieceOnMoveField.color() == color) {
         return true;
     } else {
-        potentialMoves.emplace_back(cp, currentField, potentialMoveField, std::set<MoveModifier>{MoveModifier::CAPTURE});
+        potentialMoves.push_back(Move{cp, currentField, potentialMoveField, {MoveModifier::CAPTURE}});
         return true;
     }
     return false;
 }
 
-void addPotentialPawnCaptures(std::vector<Move>& potentialMoves, const Board& board, const ChessField potentialCaptureTargetField,
-                              const ChessPieceOnField pieceOnField) {
-    ChessPiece cp = std::get<ChessPieceIdx>(pieceOnField);
-    Color color = std::get<ColorIdx>(cp);
-    ChessField currentField = std::get<ChessFieldIdx>(pieceOnField);
-    auto potentialCaptureTarget = board.getPieceOnField(potentialCaptureTargetField);
-    if (potentialCaptureTarget.has_value() && std::get<ColorIdx>(potentialCaptureTarget.value()) != color) {
-        Move captureMove = {cp, currentField, potentialCaptureTargetField};
-        if (std::get<ChessRankIdx>(potentialCaptureTargetField) == 8 || std::get<ChessRankIdx>(potentialCaptureTargetField) == 1) {
-            captureMove.addModifier(MoveModifier::CAPTURE);
-            captureMove.addModifier(MoveModifier::PROMOTE_BISHOP);
-            potentialMoves.push_back(captureMove);
-            captureMove.clearModifiers();
-            captureMove.addModifier(MoveModifier::CAPTURE);
-            captureMove.addModifier(MoveModifier::PROMOTE_KNIGHT);
-            potentialMoves.push_back(captureMove);
-            captureMove.clearModifiers();
-            captureMove.addModifier(MoveModifier::CAPTURE);
-            captureMove.addModifier(MoveModifier::PROMOTE_ROOK);
-            potentialMoves.push_back(captureMove);
-            captureMove.clearModifiers();
-            captureMove.addModifier(MoveModifier::CAPTURE);
-            captureMove.addModifier(MoveModifier::PROMOTE_QUEEN);
-            potentialMoves.push_back(std::move(captureMove));
+static void addPromotions(MoveList& potentialMoves, Move move) {
+    for (MoveModifier promotion :
+         {MoveModifier::PROMOTE_BISHOP, MoveModifier::PROMOTE_KNIGHT, MoveModifier::PROMOTE_ROOK, MoveModifier::PROMOTE_QUEEN}) {
+        Move promotionMove = move;
+        promotionMove.addModifier(promotion);
+        potentialMoves.push_back(promotionMove);
+    }
+}
+
+template <Color color>
+static void addPotentialPawnCaptures(MoveList& potentialMoves, const Board& board, const ChessField potentialCaptureTargetField,
+                                     const ChessField currentField) {
+    using Traits = ColorTraits<color>;
+    constexpr ChessPiece cp{color, Piece::PAWN};
+
+    PieceCode potentialCaptureTarget = board.getPieceCode(potentialCaptureTargetField);
+    if (potentialCaptureTarget && potentialCaptureTarget.color() == Traits::opponent) {
+        Move captureMove{cp, currentField, potentialCaptureTargetField, {MoveModifier::CAPTURE}};
+        if (std::get<ChessRankIdx>(potentialCaptureTargetField) == Traits::promotionRank) {
+            addPromotions(potentialMoves, captureMove);
         } else {
-            captureMove.addModifier(MoveModifier::CAPTURE);
-            potentialMoves.push_back(std::move(captureMove));
+            potentialMoves.push_back(captureMove);
         }
     } else if (potentialCaptureTargetField == board.getEnPassantTarget()) {
-        potentialMoves.emplace_back(cp, currentField, potentialCaptureTargetField,
-                                    std::set<MoveModifier>{MoveModifier::CAPTURE, MoveModifier::EN_PASSANT});
+        potentialMoves.push_back(Move{cp, currentField, potentialCaptureTargetField, {MoveModifier::CAPTURE, MoveModifier::EN_PASSANT}});
     }
 }
 
-std::vector<Move> PawnRules::getPotentialMoves(const Board& board, ChessPieceOnField pieceOnField) {
-    std::vector<Move> potentialMoves;
-    potentialMoves.reserve(4);
-
-    ChessPiece cp = std::get<ChessPieceIdx>(pieceOnField);
-    Color color = std::get<ColorIdx>(cp);
+void PawnRules::getPotentialMoves(const Board& board, ChessPieceOnField pieceOnField, MoveList& potentialMoves) {
     ChessField currentField = std::get<ChessFieldIdx>(pieceOnField);
+    dispatchColor(std::get<ColorIdx>(std::get<ChessPieceIdx>(pieceOnField)),
+                  [&]<Color color>() { getPotentialMoves<color>(board, currentField, potentialMoves); });
+}
+
+template <Color color>
+void PawnRules::getPotentialMoves(const Board& board, ChessField currentField, MoveList& potentialMoves) {
+    using Traits = ColorTraits<color>;
+    constexpr ChessPiece cp{color, Piece::PAWN};
     ChessFile currentFile = std::get<ChessFileIdx>(currentField);
-    ChessFile currentRank = std::get<ChessRankIdx>(currentField);
+    ChessRank currentRank = std::get<ChessRankIdx>(currentField);
 
     assert(board.whosTurnIsIt() == color);
 
-    int doubleMoveRank = (color == Color::WHITE ? 2 : 7);
-    int direction = (color == Color::WHITE ? 1 : -1);
-
-    ChessField potentialEndField = {currentFile, currentRank + direction};
-    if (!board.getPieceOnField(potentialEndField).has_value()) {
+    ChessField potentialEndField = {currentFile, currentRank + Traits::pawnDirection};
+    if (board.getPieceCode(potentialEndField).empty()) {
         Move singleStep = {cp, currentField, potentialEndField};
 
-        if (std::get<ChessRankIdx>(potentialEndField) == 8 || std::get<ChessRankIdx>(potentialEndField) == 1) {
+        if (std::get<ChessRankIdx>(potentialEndField) == Traits::promotionRank) {
             // Single step onto last rank
-            singleStep.addModifier(MoveModifier::PROMOTE_BISHOP);
-            potentialMoves.push_back(singleStep);
-            singleStep.clearModifiers();
-            singleStep.addModifier(MoveModifier::PROMOTE_KNIGHT);
-            potentialMoves.push_back(singleStep);
-            singleStep.clearModifiers();
-            singleStep.addModifier(MoveModifier::PROMOTE_ROOK);
-            potentialMoves.push_back(singleStep);
-            singleStep.clearModifiers();
-            singleStep.addModifier(MoveModifier::PROMOTE_QUEEN);
-            potentialMoves.push_back(singleStep);
+            addPromotions(potentialMoves, singleStep);
         } else {
             // Single step somewhere
             potentialMoves.push_back(singleStep);
         }
-        if (currentRank == doubleMoveRank) {
+        if (currentRank == Traits::doubleStepRank) {
             // Double step from rank 2 or 7
-            std::get<ChessRankIdx>(potentialEndField) = currentRank + (2 * direction);
-            if (!board.getPieceOnField(potentialEndField).has_value()) {
-                Move doubleStep = {cp, currentField, potentialEndField};
-                potentialMoves.push_back(doubleStep);
+            std::get<ChessRankIdx>(potentialEndField) = currentRank + (2 * Traits::pawnDirection);
+            if (board.getPieceCode(potentialEndField).empty()) {
+                potentialMoves.emplace_back(cp, currentField, potentialEndField);
             }
         }
     }
     if (currentFile != A) {
-        ChessField potentialCaptureTargetField = {currentFile - 1, currentRank + direction};
-        addPotentialPawnCaptures(potentialMoves, board, potentialCaptureTargetField, pieceOnField);
+        ChessField potentialCaptureTargetField = {currentFile - 1, currentRank + Traits::pawnDirection};
+        addPotentialPawnCaptures<color>(potentialMoves, board, potentialCaptureTargetField, currentField);
     }
     if (currentFile != H) {
-        ChessField potentialCaptureTargetField = {currentFile + 1, currentRank + direction};
-        addPotentialPawnCaptures(potentialMoves, board, potentialCaptureTargetField, pieceOnField);
+        ChessField potentialCaptureTargetField = {currentFile + 1, currentRank + Traits::pawnDirection};
+        addPotentialPawnCaptures<color>(potentialMoves, board, potentialCaptureTargetField, currentField);
     }
+}
+
+template void PawnRules::getPotentialMoves<Color::WHITE>(const Board&, ChessField, MoveList&);
+template void PawnRules::getPotentialMoves<Color::BLACK>(const Board&, ChessField, MoveList&);
 
-    return potentialMoves;
+std::vector<Move> PawnRules::getPotentialMoves(const Board& board, ChessPieceOnField pieceOnField) {
+    return collectPotentialMoves<PawnRules>(board, pieceOnField);
 }
 
 char PawnRules::getDebugChar(Color color) { return color == Color::WHITE ? 'P' : 'p'; }
 
-std::vector<Move> BishopRules::getPotentialMoves(const Board& board, ChessPieceOnField pieceOnField) {
-    std::vector<Move> potentialMoves;
-    potentialMoves.reserve(14);
+void BishopRules::getPotentialMoves(const Board& board, ChessPieceOnField pieceOnField, MoveList& potentialMoves) {
     ChessField currentField = std::get<ChessFieldIdx>(pieceOnField);
     ChessFile currentFile = std::get<ChessFileIdx>(currentField);
     ChessFile currentRank = std::get<ChessRankIdx>(currentField);
@@ -161,15 +155,15 @@ std::vector<Move> BishopRules::getPotentialMoves(const Board& board, ChessPieceO
         ChessField potentialMoveField = {currentFile - distance, currentRank - distance};
         if (addMoveOrIsBlocked(board, potentialMoveField, potentialMoves, pieceOnField)) break;
     }
+}
 
-    return potentialMoves;
+std::vector<Move> BishopRules::getPotentialMoves(const Board& board, ChessPieceOnField pieceOnField) {
+    return collectPotentialMoves<BishopRules>(board, pieceOnField);
 }
 
 char BishopRules::getDebugChar(Color color) { return color == Color::WHITE ? 'B' : 'b'; }
 
-std::vector<Move> KnightRules::getPotentialMoves(const Board& board, ChessPieceOnField pieceOnField) {
-    std::vector<Move> potentialMoves;
-    potentialMoves.reserve(8);
+void KnightRules::getPotentialMoves(const Board& board, ChessPieceOnField pieceOnField, MoveList& potentialMoves) {
     ChessField currentField = std::get<ChessFieldIdx>(pieceOnField);
     ChessFile currentFile = std::get<ChessFileIdx>(currentField);
     ChessFile currentRank = std::get<ChessRankIdx>(currentField);
@@ -182,15 +176,15 @@ std::vector<Move> KnightRules::getPotentialMoves(const Board& board, ChessPieceO
     addMoveOrIsBlocked(board, {currentFile - 1, currentRank + 2}, potentialMoves, pieceOnField);
     addMoveOrIsBlocked(board, {currentFile + 1, currentRank - 2}, potentialMoves, pieceOnField);
     addMoveOrIsBlocked(board, {currentFile + 1, currentRank + 2}, potentialMoves, pieceOnField);
+}
 
-    return potentialMoves;
+std::vector<Move> KnightRules::getPotentialMoves(const Board& board, ChessPieceOnField pieceOnField) {
+    return collectPotentialMoves<KnightRules>(board, pieceOnField);
 }
 
 char KnightRules::getDebugChar(Color color) { return color == Color::WHITE ? 'N' : 'n'; }
 
-std::vector<Move> RookRules::getPotentialMoves(const Board& board, ChessPieceOnField pieceOnField) {
-    std::vector<Move> potentialMoves;
-    potentialMoves.reserve(14);
+void RookRules::getPotentialMoves(const Board& board, ChessPieceOnField pieceOnField, MoveList& potentialMoves) {
     ChessField currentField = std::get<ChessFieldIdx>(pieceOnField);
     ChessFile currentFile = std::get<ChessFileIdx>(currentField);
     ChessRank currentRank = std::get<ChessRankIdx>(currentField);
@@ -214,31 +208,39 @@ std::vector<Move> RookRules::getPotentialMoves(const Board& board, ChessPieceOnF
         ChessField potentialMoveField = {currentFile, rank};
         if (addMoveOrIsBlocked(board, potentialMoveField, potentialMoves, pieceOnField)) break;
     }
+}
 
-    return potentialMoves;
+std::vector<Move> RookRules::getPotentialMoves(const Board& board, ChessPieceOnField pieceOnField) {
+    return collectPotentialMoves<RookRules>(board, pieceOnField);
 }
 
 char RookRules::getDebugChar(Color color) { return color == Color::WHITE ? 'R' : 'r'; }
 
-std::vector<Move> QueenRules::getPotentialMoves(const Board& board, ChessPieceOnField pieceOnField) {
-    std::vector<Move> potentialMoves;
-    potentialMoves.reserve(28);
-
-    base::push_back(potentialMoves, RookRules::getPotentialMoves(board, pieceOnField));
-    base::push_back(potentialMoves, BishopRules::getPotentialMoves(board, pieceOnField));
+void QueenRules::getPotentialMoves(const Board& board, ChessPieceOnField pieceOnField, MoveList& potentialMoves) {
+    RookRules::getPotentialMoves(board, pieceOnField, potentialMoves);
+    BishopRules::getPotentialMoves(board, pieceOnField, potentialMoves);
+}
 
-    return potentialMoves;
+std::vector<Move> QueenRules::getPotentialMoves(const Board& board, ChessPieceOnField pieceOnField) {
+    return collectPotentialMoves<QueenRules>(board, pieceOnField);
 }
 
 char QueenRules::getDebugChar(Color color) { return color == Color::WHITE ? 'Q' : 'q'; }
 
-std::vector<Move> KingRules::getPotentialMoves(const Board& board, ChessPieceOnField pieceOnField) {
-    std::vector<Move> potentialMoves;
-    potentialMoves.reserve(8);
-    ChessPiece cp = std::get<ChessPieceIdx>(pieceOnField);
+void KingRules::getPotentialMoves(const Board& board, ChessPieceOnField pieceOnField, MoveList& potentialMoves) {
     ChessField currentField = std::get<ChessFieldIdx>(pieceOnField);
+    dispatchColor(std::get<ColorIdx>(std::get<ChessPieceIdx>(pieceOnField)),
+                  [&]<Color color>() { getPotentialMoves<color>(board, currentField, potentialMoves); });
+}
+
+template <Color color>
+void KingRules::getPotentialMoves(const Board& board, ChessField currentField, MoveList& potentialMoves) {
+    using Traits = ColorTraits<color>;
+    constexpr ChessPiece cp{color, Piece::KING};
+    constexpr ChessRank rank = Traits::baseRank;
+    ChessPieceOnField pieceOnField{cp, currentField};
     ChessFile currentFile = std::get<ChessFileIdx>(currentField);
-    ChessFile currentRank = std::get<ChessRankIdx>(currentField);
+    ChessRank currentRank = std::get<ChessRankIdx>(currentField);
 
     addMoveOrIsBlocked(board, {currentFile + 1, currentRank + 1}, potentialMoves, pieceOnField);
     addMoveOrIsBlocked(board, {currentFile + 1, currentRank - 1}, potentialMoves, pieceOnField);
@@ -249,36 +251,31 @@ std::vector<Move> KingRules::getPotentialMoves(const Board& board, ChessPieceOnF
     addMoveOrIsBlocked(board, {currentFile - 1, currentRank - 1}, potentialMoves, pieceOnField);
     addMoveOrIsBlocked(board, {currentFile - 1, currentRank}, potentialMoves, pieceOnField);
 
-    if (board.whosTurnIsIt() == Color::WHITE) {
-        if (board.canCastle(Board::Castling::WHITE_LONG)) {
-            if (!board.getPieceOnField({B, 1}).has_value() && !board.getPieceOnField({C, 1}).has_value() &&
-                !board.getPieceOnField({D, 1}).has_value()) {
-                potentialMoves.emplace_back(cp, currentField, ChessField{C, 1}, std::set<MoveModifier>{MoveModifier::CASTLING_LONG});
-            }
-        }
-        if (board.canCastle(Board::Castling::WHITE_SHORT)) {
-            if (!board.getPieceOnField({F, 1}).has_value() && !board.getPieceOnField({G, 1}).has_value()) {
-                potentialMoves.emplace_back(cp, currentField, ChessField{G, 1}, std::set<MoveModifier>{MoveModifier::CASTLING_SHORT});
-            }
+    if (board.canCastle(Traits::castlingLong)) {
+        if (board.getPieceCode({B, rank}).empty() && board.getPieceCode({C, rank}).empty() && board.getPieceCode({D, rank}).empty()) {
+            potentialMoves.push_back(Move{cp, currentField, ChessField{C, rank}, {MoveModifier::CASTLING_LONG}});
         }
-    } else {
-        if (board.canCastle(Board::Castling::BLACK_LONG)) {
-            if (!board.getPieceOnField({B, 8}).has_value() && !board.getPieceOnField({C, 8}).has_value() &&
-                !board.getPieceOnField({D, 8}).has_value()) {
-                potentialMoves.emplace_back(cp, currentField, ChessField{C, 8}, std::set<MoveModifier>{MoveModifier::CASTLING_LONG});
-            }
-        }
-        if (board.canCastle(Board::Castling::BLACK_SHORT)) {
-            if (!board.getPieceOnField({F, 8}).has_value() && !board.getPieceOnField({G, 8}).has_value()) {
-                potentialMoves.emplace_back(cp, currentField, ChessField{G, 8}, std::set<MoveModifier>{MoveModifier::CASTLING_SHORT});
-            }
+    }
+    if (board.canCastle(Traits::castlingShort)) {
+        if (board.getPieceCode({F, rank}).empty() && board.getPieceCode({G, rank}).empty()) {
+            potentialMoves.push_back(Move{cp, currentField, ChessField{G, rank}, {MoveModifier::CASTLING_SHORT}});
         }
     }
-    return potentialMoves;
+}
+
+template void KingRules::getPotentialMoves<Color::WHITE>(const Board&, ChessField, MoveList&);
+template void KingRules::getPotentialMoves<Color::BLACK>(const Board&, ChessField, MoveList&);
+
+std::vector<Move> KingRules::getPotentialMoves(const Board& board, ChessPieceOnField pieceOnField) {
+    return collectPotentialMoves<KingRules>(board, pieceOnField);
 }
 
 char KingRules::getDebugChar(Color color) { return color == Color::WHITE ? 'K' : 'k'; }
 
-std::vector<Move> DecoyRules::getPotentialMoves(const Board&, ChessPieceOnField) { return {}; }
+void DecoyRules::getPotentialMoves(const Board&, ChessPieceOnField, MoveList&) {}
+
+std::vector<Move> DecoyRules::getPotentialMoves(const Board& board, ChessPieceOnField pieceOnField) {
+    return collectPotentialMoves<DecoyRules>(board, pieceOnField);
+}
 
 char DecoyRules::getDebugChar(Color color) { return color == Color::WHITE ? 'X' : 'x'; }
\ No newline at end of file
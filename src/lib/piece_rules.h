@@ -6,45 +6,63 @@
 
 class Board;
 class Move;
+class MoveList;
 
 class PawnRules {
    public:
     static std::vector<Move> getPotentialMoves(const Board& board, ChessPieceOnField pieceOnField);
+    static void getPotentialMoves(const Board& board, ChessPieceOnField pieceOnField, MoveList& potentialMoves);
+    /**
+     * @brief Same as above with the color of the piece known at compile time, instantiated for both colors
+     */
+    template <Color color>
+    static void getPotentialMoves(const Board& board, ChessField field, MoveList& potentialMoves);
     static char getDebugChar(Color color);
 };
 
 class BishopRules {
    public:
     static std::vector<Move> getPotentialMoves(const Board& board, ChessPieceOnField pieceOnField);
+    static void getPotentialMoves(const Board& board, ChessPieceOnField pieceOnField, MoveList& potentialMoves);
     static char getDebugChar(Color color);
 };
 
 class KnightRules {
    public:
     static std::vector<Move> getPotentialMoves(const Board& board, ChessPieceOnField pieceOnField);
+    static void getPotentialMoves(const Board& board, ChessPieceOnField pieceOnField, MoveList& potentialMoves);
     static char getDebugChar(Color color);
 };
 
 class RookRules {
    public:
     static std::vector<Move> getPotentialMoves(const Board& board, ChessPieceOnField pieceOnField);
+    static void getPotentialMoves(const Board& board, ChessPieceOnField pieceOnField, MoveList& potentialMoves);
     static char getDebugChar(Color color);
 };
 
 class QueenRules {
    public:
     static std::vector<Move> getPotentialMoves(const Board& board, ChessPieceOnField pieceOnField);
+    static void getPotentialMoves(const Board& board, ChessPieceOnField pieceOnField, MoveList& potentialMoves);
     static char getDebugChar(Color color);
 };
 
 class KingRules {
    public:
     static std::vector<Move> getPotentialMoves(const Board& board, ChessPieceOnField pieceOnField);
+    static void getPotentialMoves(const Board& board, ChessPieceOnField pieceOnField, MoveList& potentialMoves);
+    /**
+     * @brief Same as above with the color of the piece known at compile time, instantiated for both colors
+     */
+    template <Color color>
+    static void getPotentialMoves(const Board& board, ChessField field, MoveList& potentialMoves);
     static char getDebugChar(Color color);
 };
 
 class DecoyRules {
    public:
     static std::vector<Move> getPotentialMoves(const Board& board, ChessPieceOnField pieceOnField);
+    static void getPotentialMoves(const Board& board, ChessPieceOnField pieceOnField, MoveList& potentialMoves);
     static char getDebugChar(Color color);
 };
\ No newline at end of file
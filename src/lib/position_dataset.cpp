@@ -0,0 +1,109 @@
+#include "position_dataset.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+static uint64_t readLittleEndian(const char* data, int bytes) {
+    uint64_t value = 0;
+    for (int i = bytes - 1; i >= 0; --i) value = (value << 8) | static_cast<unsigned char>(data[i]);
+    return value;
+}
+
+static void writeLittleEndian(char* data, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) data[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+}
+
+PositionDataset::PositionDataset(const std::string& path) { open(path); }
+
+bool PositionDataset::open(const std::string& path) {
+    close();
+    if (!_file.open(path)) return false;
+
+    const char* header = _file.data();
+    bool valid = _file.size() >= HeaderSize && std::memcmp(header, Magic, sizeof(Magic)) == 0 &&
+                 readLittleEndian(header + 8, 4) == Version && readLittleEndian(header + 12, 4) == PackedPosition::Size;
+    uint64_t count = (valid ? readLittleEndian(header + 16, 8) : 0);
+    if (!valid || count > (_file.size() - HeaderSize) / PackedPosition::Size) {
+        _file.close();
+        return false;
+    }
+
+    _size = count;
+    _file.adviseAccess(MappedFile::Access::RANDOM);
+    return true;
+}
+
+void PositionDataset::close() {
+    _file.close();
+    _size = 0;
+}
+
+bool PositionDataset::isOpen() const { return _file.isOpen(); }
+
+size_t PositionDataset::size() const { return _size; }
+
+const uint8_t* PositionDataset::record(size_t index) const {
+    assert(index < _size);
+    return reinterpret_cast<const uint8_t*>(_file.data() + HeaderSize + index * PackedPosition::Size);
+}
+
+bool PositionDataset::get(size_t index, Board& board) const { return PackedPosition::unpack(record(index), board); }
+
+Board PositionDataset::operator[](size_t index) const {
+    Board board;
+    [[maybe_unused]] bool valid = get(index, board);
+    assert(valid);
+    return board;
+}
+
+PositionDataset::Shard PositionDataset::shard(size_t shardIndex, size_t shardCount) const {
+    assert(shardCount > 0 && shardIndex < shardCount);
+    // The first size % shardCount shards get one position more
+    size_t base = _size / shardCount;
+    size_t extra = _size % shardCount;
+    size_t begin = shardIndex * base + std::min(shardIndex, extra);
+    size_t end = begin + base + (shardIndex < extra ? 1 : 0);
+    return Shard(this, begin, end);
+}
+
+PositionDatasetWriter::~PositionDatasetWriter() { close(); }
+
+bool PositionDatasetWriter::writeHeader() {
+    char header[PositionDataset::HeaderSize] = {};
+    std::memcpy(header, PositionDataset::Magic, sizeof(PositionDataset::Magic));
+    writeLittleEndian(header + 8, PositionDataset::Version, 4);
+    writeLittleEndian(header + 12, PackedPosition::Size, 4);
+    writeLittleEndian(header + 16, _count, 8);
+    return std::fwrite(header, 1, sizeof(header), _file) == sizeof(header);
+}
+
+bool PositionDatasetWriter::open(const std::string& path) {
+    close();
+    _file = std::fopen(path.c_str(), "wb");
+    if (_file == nullptr) return false;
+    _count = 0;
+    _failed = !writeHeader();
+    return !_failed;
+}
+
+bool PositionDatasetWriter::close() {
+    if (_file == nullptr) return false;
+    bool written = !_failed && std::fseek(_file, 0, SEEK_SET) == 0 && writeHeader();
+    written = (std::fclose(_file) == 0) && written;
+    _file = nullptr;
+    return written;
+}
+
+void PositionDatasetWriter::add(const PackedPosition& position) {
+    assert(_file != nullptr);
+    if (std::fwrite(position.bytes.data(), 1, PackedPosition::Size, _file) != PackedPosition::Size) _failed = true;
+    ++_count;
+}
+
+bool PositionDatasetWriter::add(const Board& board) {
+    std::optional<PackedPosition> packed = PackedPosition::pack(board);
+    if (!packed) return false;
+    add(*packed);
+    return true;
+}
@@ -0,0 +1,164 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <string>
+
+#include "base/helpers.h"
+#include "board.h"
+#include "mapped_file.h"
+#include "packed_position.h"
+
+/**
+ * @brief File of packed positions with random access
+ *
+ * The file starts with a 32 byte header, followed by the PackedPosition records:
+ * - bytes  0-7   magic "CHESSPOS"
+ * - bytes  8-11  format version
+ * - bytes 12-15  record size (PackedPosition::Size)
+ * - bytes 16-23  number of records
+ * - bytes 24-31  reserved, zero
+ * All numbers are little-endian.
+ *
+ * The file is memory mapped, so opening is instant whatever the size and the page cache of the OS
+ * holds the data. Records are decoded on access. Use shards to split the dataset between threads.
+ */
+class PositionDataset : base::NONCOPYABLE {
+   public:
+    static constexpr char Magic[8] = {'C', 'H', 'E', 'S', 'S', 'P', 'O', 'S'};
+    static constexpr uint32_t Version = 1;
+    static constexpr size_t HeaderSize = 32;
+
+    PositionDataset() = default;
+    explicit PositionDataset(const std::string& path);
+
+    /**
+     * @brief Map a dataset file
+     *
+     * @return bool - Is it a dataset file of a supported version with all records present?
+     */
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const;
+
+    /**
+     * @brief Number of positions
+     */
+    size_t size() const;
+
+    /**
+     * @brief Decode a position. The record must be valid, use get() for files of unknown origin.
+     */
+    Board operator[](size_t index) const;
+
+    /**
+     * @brief Decode a position
+     *
+     * @return bool - Was the record a valid position?
+     */
+    bool get(size_t index, Board& board) const;
+
+    /**
+     * @brief Raw bytes of a record, PackedPosition::Size bytes
+     */
+    const uint8_t* record(size_t index) const;
+
+    /**
+     * @brief A contiguous range of positions, iterating yields the decoded Boards
+     */
+    class Shard {
+       public:
+        class iterator {
+           public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = Board;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = Board;
+
+            iterator(const PositionDataset* dataset, size_t index) : _dataset(dataset), _index(index) {}
+            Board operator*() const { return (*_dataset)[_index]; }
+            iterator& operator++() {
+                ++_index;
+                return *this;
+            }
+            bool operator==(const iterator& other) const { return _index == other._index; }
+            size_t index() const { return _index; }
+
+           private:
+            const PositionDataset* _dataset;
+            size_t _index;
+        };
+
+        Shard(const PositionDataset* dataset, size_t begin, size_t end) : _dataset(dataset), _begin(begin), _end(end) {}
+        iterator begin() const { return iterator(_dataset, _begin); }
+        iterator end() const { return iterator(_dataset, _end); }
+        size_t size() const { return _end - _begin; }
+
+       private:
+        const PositionDataset* _dataset;
+        size_t _begin;
+        size_t _end;
+    };
+
+    /**
+     * @brief One of shardCount nearly equally sized, disjoint parts of the dataset
+     *
+     * @param shardIndex  0 <= shardIndex < shardCount, e.g. the index of the thread
+     * @param shardCount  Number of shards, e.g. the number of threads
+     */
+    Shard shard(size_t shardIndex, size_t shardCount) const;
+
+    /**
+     * @brief The whole dataset
+     */
+    Shard all() const { return shard(0, 1); }
+
+   private:
+    MappedFile _file;
+    size_t _size = 0;
+};
+
+/**
+ * @brief Writes a PositionDataset file
+ *
+ * The record count in the header is written on close, so the file has to be seekable.
+ */
+class PositionDatasetWriter : base::NONCOPYABLE {
+   public:
+    PositionDatasetWriter() = default;
+    ~PositionDatasetWriter();
+
+    /**
+     * @brief Create the file and write a preliminary header
+     *
+     * @return bool - Could the file be created?
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief Finish the header and close the file
+     *
+     * @return bool - Was everything written?
+     */
+    bool close();
+
+    void add(const PackedPosition& position);
+
+    /**
+     * @brief Pack and add a board
+     *
+     * @return bool - Could the board be packed?
+     */
+    bool add(const Board& board);
+
+    size_t size() const { return _count; }
+
+   private:
+    bool writeHeader();
+
+    std::FILE* _file = nullptr;
+    size_t _count = 0;
+    bool _failed = false;
+};
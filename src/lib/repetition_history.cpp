@@ -0,0 +1,36 @@
+#include "repetition_history.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "board.h"
+#include "zobrist.h"
+
+void RepetitionHistory::push(const Board& board) { push(Zobrist::hash(board), board.getHalfMoveClock()); }
+
+void RepetitionHistory::push(uint64_t key, uint32_t halfMoveClock) { _entries.push_back(Entry{key, halfMoveClock}); }
+
+void RepetitionHistory::pop() {
+    assert(!_entries.empty());
+    _entries.pop_back();
+}
+
+void RepetitionHistory::clear() { _entries.clear(); }
+
+void RepetitionHistory::reserve(size_t positions) { _entries.reserve(positions); }
+
+size_t RepetitionHistory::size() const { return _entries.size(); }
+
+int RepetitionHistory::countRepetitions() const {
+    if (_entries.size() < 5) return 0;
+    const Entry& last = _entries.back();
+    // Both sides need at least two moves to get back to a position
+    size_t reversiblePlies = std::min<size_t>(last.halfMoveClock, _entries.size() - 1);
+    int repetitions = 0;
+    for (size_t back = 4; back <= reversiblePlies; back += 2) {
+        if (_entries[_entries.size() - 1 - back].key == last.key) ++repetitions;
+    }
+    return repetitions;
+}
+
+bool RepetitionHistory::isThreefoldRepetition() const { return countRepetitions() >= 2; }
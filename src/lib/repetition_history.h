@@ -0,0 +1,57 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "base/helpers.h"
+
+class Board;
+
+/**
+ * @brief Zobrist keys of the positions of a game, to detect repeated positions
+ *
+ * A position can only repeat as long as no pawn moved and nothing was captured, so a lookup scans back
+ * only over the plies counted by the half move clock, and only over every second one, as the side to move
+ * must be the same. Searches push and pop keys while walking the tree, games only push.
+ */
+class RepetitionHistory {
+   public:
+    /**
+     * @brief Pushes a position for as long as the guard lives
+     */
+    class Guard : base::NONCOPYANDMOVEABLE {
+       public:
+        Guard(RepetitionHistory& history, const Board& board) : _history(history) { _history.push(board); }
+        Guard(RepetitionHistory& history, uint64_t key, uint32_t halfMoveClock) : _history(history) {
+            _history.push(key, halfMoveClock);
+        }
+        ~Guard() { _history.pop(); }
+
+       private:
+        RepetitionHistory& _history;
+    };
+
+    void push(const Board& board);
+    void push(uint64_t key, uint32_t halfMoveClock);
+    void pop();
+    void clear();
+    void reserve(size_t positions);
+    size_t size() const;
+
+    /**
+     * @brief How often the last pushed position occurred before
+     */
+    int countRepetitions() const;
+
+    /**
+     * @brief The last pushed position occurred at least twice before, so a player can claim a draw
+     */
+    bool isThreefoldRepetition() const;
+
+   private:
+    struct Entry {
+        uint64_t key;
+        uint32_t halfMoveClock;
+    };
+    std::vector<Entry> _entries;
+};
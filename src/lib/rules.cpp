@@ -1,23 +1,19 @@
 #include "rules.h"
 
-#include <base/improve_containers.h>
-
+#include <array>
 #include <cassert>
+#include <cstdlib>
 #include <iostream>
 
 #include "bench.h"
 #include "board.h"
 #include "board_factory.h"
+#include "color_traits.h"
 #include "move.h"
+#include "move_list.h"
 #include "piece_rules.h"
 #include "types.h"
 
-static std::map<Piece, std::function<std::vector<Move>(const Board& board, ChessPieceOnField pieceOnField)>> pieceRules = {
-    {Piece::PAWN, PawnRules::getPotentialMoves},     {Piece::BISHOP, BishopRules::getPotentialMoves},
-    {Piece::KNIGHT, KnightRules::getPotentialMoves}, {Piece::ROOK, RookRules::getPotentialMoves},
-    {Piece::QUEEN, QueenRules::getPotentialMoves},   {Piece::KING, KingRules::getPotentialMoves},
-    {Piece::DECOY, DecoyRules::getPotentialMoves}};
-
 inline constexpr Color getOppositeColor(Color color) { return (color == Color::WHITE ? Color::BLACK : Color::WHITE); }
 
 bool ChessRules::isCheck(const Board& board) {
@@ -30,39 +26,222 @@ bool ChessRules::isCheck(const Board& board) {
     return isFieldCoveredByColor(board, kingField, getOppositeColor(board.whosTurnIsIt()));
 };
 
-bool ChessRules::isCheckMate(const Board& board, bool checkHint) {
-    if (checkHint || isCheck(board)) {
-        auto moves = getAllValidMoves(board, false);
-        if (moves.size() == 0) {
-            return true;
-        }
+bool ChessRules::isCheckMate(const Board& board, bool checkHint) { return (checkHint || isCheck(board)) && !hasValidMove(board); }
+
+bool ChessRules::isStaleMate(const Board& board, bool checkHint) { return (!checkHint || !isCheck(board)) && !hasValidMove(board); }
+
+bool ChessRules::isGameOver(const Board& board) { return evaluateStatus(board) != GameStatus::ONGOING; }
+
+bool ChessRules::hasValidMove(const Board& board) {
+    MoveList potentialMoves;
+    getAllPotentialMoves(board, potentialMoves);
+    for (const Move& potentialMove : potentialMoves) {
+        if (isMoveLegal(board, potentialMove)) return true;
     }
     return false;
-};
+}
 
-bool ChessRules::isStaleMate(const Board& board, bool checkHint) {
-    if (!checkHint || !isCheck(board)) {
-        auto moves = getAllValidMoves(board, false);
-        if (moves.size() == 0) {
-            return true;
-        }
+static GameStatus statusOf(const Board& board, bool hasValidMove) {
+    if (!hasValidMove) return ChessRules::isCheck(board) ? GameStatus::CHECK_MATE : GameStatus::STALE_MATE;
+    return board.getHalfMoveClock() > 50 ? GameStatus::FIFTY_MOVE_RULE : GameStatus::ONGOING;
+}
+
+GameStatus ChessRules::evaluateStatus(const Board& board, std::vector<Move>& validMoves) {
+    MoveList moves;
+    getAllValidMoves(board, moves, false);
+    // Assigning keeps the capacity of the vector, so callers reusing it do not allocate per position
+    validMoves.assign(moves.begin(), moves.end());
+    return statusOf(board, !validMoves.empty());
+}
+
+GameStatus ChessRules::evaluateStatus(const Board& board, MoveList& validMoves) {
+    validMoves.clear();
+    getAllValidMoves(board, validMoves, false);
+    return statusOf(board, !validMoves.empty());
+}
+
+GameStatus ChessRules::evaluateStatus(const Board& board) { return statusOf(board, hasValidMove(board)); }
+
+// BoardView is a Board or a BoardAfterMove, anything with getPieceCode(ChessField)
+template <typename BoardView>
+static bool hasPieceOnField(const BoardView& board, ChessFile file, ChessRank rank, PieceCode piece) {
+    if (file < A || file > H || rank < 1 || rank > 8) return false;
+    return board.getPieceCode({file, rank}) == piece;
+}
+
+// Walks from the field in one direction until the first piece and checks if it is one of the two sliders
+template <typename BoardView>
+static bool isAttackedAlongRay(const BoardView& board, ChessField field, int fileStep, int rankStep, PieceCode slider, PieceCode queen) {
+    ChessFile file = std::get<ChessFileIdx>(field) + fileStep;
+    ChessRank rank = std::get<ChessRankIdx>(field) + rankStep;
+    for (; file >= A && file <= H && rank >= 1 && rank <= 8; file += fileStep, rank += rankStep) {
+        PieceCode cp = board.getPieceCode({file, rank});
+        if (cp) return cp == slider || cp == queen;
+    }
+    return false;
+}
+
+bool ChessRules::isFieldCoveredByColor(const Board& board, const ChessField& field, Color color) {
+    static constexpr int KnightSteps[8][2] = {{1, 2}, {2, 1}, {2, -1}, {1, -2}, {-1, -2}, {-2, -1}, {-2, 1}, {-1, 2}};
+    static constexpr int KingSteps[8][2] = {{0, 1}, {1, 1}, {1, 0}, {1, -1}, {0, -1}, {-1, -1}, {-1, 0}, {-1, 1}};
+    auto [file, rank] = field;
+
+    // Pawns capture diagonally forward, so an attacking pawn stands diagonally behind the field
+    ChessRank pawnRank = rank + (color == Color::WHITE ? -1 : 1);
+    PieceCode pawn = ChessPiece{color, Piece::PAWN};
+    if (hasPieceOnField(board, file - 1, pawnRank, pawn) || hasPieceOnField(board, file + 1, pawnRank, pawn)) return true;
+
+    PieceCode knight = ChessPiece{color, Piece::KNIGHT};
+    for (const auto& [fileStep, rankStep] : KnightSteps) {
+        if (hasPieceOnField(board, file + fileStep, rank + rankStep, knight)) return true;
+    }
+    PieceCode king = ChessPiece{color, Piece::KING};
+    for (const auto& [fileStep, rankStep] : KingSteps) {
+        if (hasPieceOnField(board, file + fileStep, rank + rankStep, king)) return true;
+    }
+
+    PieceCode queen = ChessPiece{color, Piece::QUEEN};
+    for (const auto& [fileStep, rankStep] : KingSteps) {
+        bool diagonal = (fileStep != 0 && rankStep != 0);
+        PieceCode slider = ChessPiece{color, diagonal ? Piece::BISHOP : Piece::ROOK};
+        if (isAttackedAlongRay(board, field, fileStep, rankStep, slider, queen)) return true;
     }
     return false;
+}
+
+/**
+ * @brief The board as it would be after a move, without copying it
+ *
+ * A move changes at most four fields (castling), all other fields are read from the board.
+ */
+class BoardAfterMove {
+   public:
+    explicit BoardAfterMove(const Board& board) : _board(board) {}
+
+    void setField(ChessField field, PieceCode piece) {
+        assert(_changes < MaxChanges);
+        _fields[_changes] = field;
+        _pieces[_changes++] = piece;
+    }
+
+    PieceCode getPieceCode(ChessField field) const {
+        for (size_t i = 0; i < _changes; ++i) {
+            if (_fields[i] == field) return _pieces[i];
+        }
+        return _board.getPieceCode(field);
+    }
+
+    size_t changes() const { return _changes; }
+    ChessField changedField(size_t index) const { return _fields[index]; }
+
+   private:
+    static constexpr size_t MaxChanges = 4;
+
+    const Board& _board;
+    std::array<ChessField, MaxChanges> _fields;
+    std::array<PieceCode, MaxChanges> _pieces;
+    size_t _changes = 0;
 };
 
-bool ChessRules::isGameOver(const Board& board) { return isCheckMate(board) || isStaleMate(board) || board.getHalfMoveClock() > 50; }
+static std::optional<ChessField> findKing(const Board& board, Color color) {
+    PieceCode king = ChessPiece{color, Piece::KING};
+    for (int index = 0; index < 64; ++index) {
+        Square square = Square::fromIndex(index);
+        if (board.getPieceCode(square) == king) return square;
+    }
+    return std::nullopt;
+}
 
-bool ChessRules::isFieldCoveredByColor(const Board& board, const ChessField& field, Color color) {
-    Board tempBoard(board);
-    Color oppositeColor = getOppositeColor(color);
+static PieceCode pieceAfterMove(const Move& move) {
+    Color color = move.getPieceCode().color();
+    if (move.hasModifier(MoveModifier::PROMOTE_QUEEN)) return ChessPiece{color, Piece::QUEEN};
+    if (move.hasModifier(MoveModifier::PROMOTE_ROOK)) return ChessPiece{color, Piece::ROOK};
+    if (move.hasModifier(MoveModifier::PROMOTE_BISHOP)) return ChessPiece{color, Piece::BISHOP};
+    if (move.hasModifier(MoveModifier::PROMOTE_KNIGHT)) return ChessPiece{color, Piece::KNIGHT};
+    return move.getPieceCode();
+}
 
-    tempBoard.setField(field, {oppositeColor, Piece::DECOY});
-    tempBoard.setTurn(color);
-    std::vector<Move> potentialMoves = getAllPotentialMoves(tempBoard);
-    int numOfCaptureMoves = base::count_if(
-        potentialMoves, [&field](const Move& move) { return (move.getEndField() == field && move.hasModifier(MoveModifier::CAPTURE)); });
+// Pawns and knights attack the king from their field, the king itself never gives check
+static bool attacksByStep(PieceCode piece, ChessField field, ChessField king) {
+    int fileDistance = std::get<ChessFileIdx>(king) - std::get<ChessFileIdx>(field);
+    int rankDistance = std::get<ChessRankIdx>(king) - std::get<ChessRankIdx>(field);
+    switch (piece.piece()) {
+        case Piece::PAWN:
+            return rankDistance == (piece.color() == Color::WHITE ? 1 : -1) && std::abs(fileDistance) == 1;
+        case Piece::KNIGHT:
+            return std::abs(fileDistance * rankDistance) == 2;
+        default:
+            return false;
+    }
+}
 
-    return (numOfCaptureMoves > 0);
+// Whether a slider of the color attacks the king along the line through the field, if the field is on a line with the king
+static bool attacksThroughField(const BoardAfterMove& board, ChessField field, ChessField king, Color color) {
+    int fileDistance = std::get<ChessFileIdx>(field) - std::get<ChessFileIdx>(king);
+    int rankDistance = std::get<ChessRankIdx>(field) - std::get<ChessRankIdx>(king);
+    bool straight = (fileDistance == 0) != (rankDistance == 0);
+    bool diagonal = fileDistance != 0 && std::abs(fileDistance) == std::abs(rankDistance);
+    if (!straight && !diagonal) return false;
+
+    PieceCode slider = ChessPiece{color, diagonal ? Piece::BISHOP : Piece::ROOK};
+    PieceCode queen = ChessPiece{color, Piece::QUEEN};
+    return isAttackedAlongRay(board, king, (fileDistance > 0) - (fileDistance < 0), (rankDistance > 0) - (rankDistance < 0), slider, queen);
+}
+
+bool ChessRules::givesCheck(const Board& board, const Move& move) {
+    Color color = move.getPieceCode().color();
+    std::optional<ChessField> king = findKing(board, getOppositeColor(color));
+    if (!king) return false;
+
+    ChessField start = move.getStartField();
+    ChessField end = move.getEndField();
+    ChessRank rank = std::get<ChessRankIdx>(start);
+    PieceCode piece = pieceAfterMove(move);
+    BoardAfterMove after(board);
+    after.setField(start, {});
+    after.setField(end, piece);
+    if (move.hasModifier(MoveModifier::EN_PASSANT)) {
+        after.setField({std::get<ChessFileIdx>(end), rank}, {});
+    } else if (move.hasModifier(MoveModifier::CASTLING_SHORT)) {
+        after.setField({H, rank}, {});
+        after.setField({F, rank}, ChessPiece{color, Piece::ROOK});
+    } else if (move.hasModifier(MoveModifier::CASTLING_LONG)) {
+        after.setField({A, rank}, {});
+        after.setField({D, rank}, ChessPiece{color, Piece::ROOK});
+    }
+
+    // Direct checks of sliders and discovered checks both show as a slider on a line through a changed field
+    if (attacksByStep(piece, end, *king)) return true;
+    for (size_t i = 0; i < after.changes(); ++i) {
+        if (attacksThroughField(after, after.changedField(i), *king, color)) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Cheap test that the side to move, which is not in check, still has a move
+ *
+ * True if the king can step to a neighboring field that is not attacked. As the king is not in check,
+ * no slider attacks through the king's field, so the attacks can be checked with the king still in place.
+ * False does not mean that there is no move, other pieces might still move.
+ */
+static bool canKingStepAside(const Board& board) {
+    Color color = board.whosTurnIsIt();
+    std::optional<ChessField> kingField = board.findFirstPiece([color](ChessPiece cp) { return cp == ChessPiece{color, Piece::KING}; });
+    if (!kingField) return false;
+
+    auto [kingFile, kingRank] = *kingField;
+    for (int fileStep = -1; fileStep <= 1; ++fileStep) {
+        for (int rankStep = -1; rankStep <= 1; ++rankStep) {
+            ChessFile file = kingFile + fileStep;
+            ChessRank rank = kingRank + rankStep;
+            if ((fileStep == 0 && rankStep == 0) || file < A || file > H || rank < 1 || rank > 8) continue;
+            PieceCode cp = board.getPieceCode({file, rank});
+            if (cp && cp.color() == color) continue;
+            if (!ChessRules::isFieldCoveredByColor(board, {file, rank}, getOppositeColor(color))) return true;
+        }
+    }
+    return false;
 }
 
 bool ChessRules::wouldMoveSelfIntoCheck(const Board& board, const Move& move) {
@@ -79,62 +258,135 @@ bool ChessRules::wouldMoveSelfIntoCheck(const Board& board, const Move& move) {
     return isFieldCoveredByColor(postMoveBoard, kingField, postMoveBoard.whosTurnIsIt());
 };
 
-std::vector<Move> ChessRules::getAllValidMoves(const Board& board, bool annotate) {
-    std::vector<Move> validMoves;
-    std::vector<Move> potentialMoves = getAllPotentialMoves(board);
+template <typename Iter>
+static void annotateRange(const Board& board, Iter first, Iter last, bool withStaleMate) {
+    for (; first != last; ++first) {
+        Move& move = *first;
+        // Looking for a legal reply is expensive, so only moves that give check are played out, unless asked for stale-mates
+        bool check = ChessRules::givesCheck(board, move);
+        if (!check && !withStaleMate) continue;
 
-    for (auto potentialMove : potentialMoves) {
-        if (ChessRules::isMoveLegal(board, potentialMove)) validMoves.push_back(potentialMove);
+        Board resultingBoard(board);
+        ChessRules::applyMove(resultingBoard, move);
+        if (check) {
+            move.addModifier(ChessRules::hasValidMove(resultingBoard) ? MoveModifier::CHECK : MoveModifier::CHECK_MATE);
+        } else if (!canKingStepAside(resultingBoard) && !ChessRules::hasValidMove(resultingBoard)) {
+            move.addModifier(MoveModifier::STALE_MATE);
+        }
     }
+}
+
+std::vector<Move> ChessRules::getAllValidMoves(const Board& board, bool annotate) {
+    MoveList validMoves;
+    getAllValidMoves(board, validMoves, annotate);
+    return validMoves.toVector();
+}
 
-    if (annotate) annotateMoves(board, validMoves);
+void ChessRules::getAllValidMoves(const Board& board, MoveList& validMoves, bool annotate) {
+    size_t first = validMoves.size();
+    getAllPotentialMoves(board, validMoves);
 
-    return validMoves;
+    // Compact the legal moves of the appended range in place
+    size_t kept = first;
+    for (size_t i = first; i < validMoves.size(); ++i) {
+        if (ChessRules::isMoveLegal(board, validMoves[i])) validMoves[kept++] = validMoves[i];
+    }
+    validMoves.truncate(kept);
+
+    if (annotate) annotateRange(board, validMoves.begin() + first, validMoves.end(), false);
 }
 
 std::vector<Move> ChessRules::getAllValidMoves(const Board& board, ChessField field, bool annotate) {
-    std::vector<Move> validMoves = getAllValidMoves(board, annotate);
+    PieceCode cp = board.getPieceCode(field);
+    if (!cp || cp.color() != board.whosTurnIsIt()) return {};
+
+    // Only the moves of this piece are generated and annotated
+    MoveList validMoves;
+    getPotentialMoves(board, ChessPieceOnField{cp, field}, validMoves);
+    validMoves.erase_if([&board](const Move& move) { return !ChessRules::isMoveLegal(board, move); });
+    if (annotate) annotateRange(board, validMoves.begin(), validMoves.end(), false);
+    return validMoves.toVector();
+}
 
-    std::erase_if(validMoves, [&field](const Move& move) { return move.getStartField() != field; });
+void ChessRules::annotateMoves(const Board& board, std::vector<Move>& moves, bool withStaleMate) {
+    annotateRange(board, moves.begin(), moves.end(), withStaleMate);
+}
 
-    return validMoves;
+void ChessRules::annotateMoves(const Board& board, MoveList& moves, bool withStaleMate) {
+    annotateRange(board, moves.begin(), moves.end(), withStaleMate);
 }
 
-void ChessRules::annotateMoves(const Board& board, std::vector<Move>& moves) {
+void ChessRules::annotateChecks(const Board& board, std::vector<Move>& moves) {
     for (auto& move : moves) {
-        Board resultingBoard(board);
-        applyMove(resultingBoard, move);
-        bool check = isCheck(resultingBoard);
+        if (givesCheck(board, move)) move.addModifier(MoveModifier::CHECK);
+    }
+}
 
-        if (isCheckMate(resultingBoard, check)) {
-            move.addModifier(MoveModifier::CHECK_MATE);
-        } else if (isStaleMate(resultingBoard, check)) {
-            move.addModifier(MoveModifier::STALE_MATE);
-        } else if (check) {
-            move.addModifier(MoveModifier::CHECK);
-        }
+void ChessRules::annotateChecks(const Board& board, MoveList& moves) {
+    for (auto& move : moves) {
+        if (givesCheck(board, move)) move.addModifier(MoveModifier::CHECK);
     }
 }
 
 std::vector<Move> ChessRules::getAllPotentialMoves(const Board& board) {
-    std::vector<Move> potentialMoves;
-
-    auto allPiecesOfRequestedColor = board.getAllPieces(board.whosTurnIsIt());
+    MoveList potentialMoves;
+    getAllPotentialMoves(board, potentialMoves);
+    return potentialMoves.toVector();
+}
 
-    for (auto pieceOnField : allPiecesOfRequestedColor) {
-        auto potentialMovesOfSinglePiece = ChessRules::getPotentialMoves(board, pieceOnField);
-        base::push_back(potentialMoves, potentialMovesOfSinglePiece);
-    };
+template <Color color>
+static void generatePotentialMoves(const Board& board, MoveList& potentialMoves) {
+    // Walk the fields directly instead of collecting the pieces into a vector first
+    for (ChessRank rank = 1; rank <= 8; ++rank) {
+        for (ChessFile file = A; file <= H; ++file) {
+            PieceCode cp = board.getPieceCode({file, rank});
+            if (!cp || cp.color() != color) continue;
+
+            ChessField field{file, rank};
+            switch (cp.piece()) {
+                case Piece::PAWN:
+                    PawnRules::getPotentialMoves<color>(board, field, potentialMoves);
+                    break;
+                case Piece::KING:
+                    KingRules::getPotentialMoves<color>(board, field, potentialMoves);
+                    break;
+                default:
+                    ChessRules::getPotentialMoves(board, ChessPieceOnField{cp, field}, potentialMoves);
+            }
+        }
+    }
+}
 
-    return potentialMoves;
+void ChessRules::getAllPotentialMoves(const Board& board, MoveList& potentialMoves) {
+    dispatchColor(board.whosTurnIsIt(), [&]<Color color>() { generatePotentialMoves<color>(board, potentialMoves); });
 }
 
-// TODO: Refactor to use polymorphic approach to get movement options per piece
 std::vector<Move> ChessRules::getPotentialMoves(const Board& board, ChessPieceOnField pieceOnField) {
+    MoveList potentialMoves;
+    getPotentialMoves(board, pieceOnField, potentialMoves);
+    return potentialMoves.toVector();
+}
+
+void ChessRules::getPotentialMoves(const Board& board, ChessPieceOnField pieceOnField, MoveList& potentialMoves) {
     ChessPiece cp = std::get<ChessPieceIdx>(pieceOnField);
-    Piece piece = std::get<PieceIdx>(cp);
 
-    return pieceRules[piece](board, pieceOnField);
+    // Called for every piece of every position, so dispatch statically rather than through a lookup table
+    switch (std::get<PieceIdx>(cp)) {
+        case Piece::PAWN:
+            return PawnRules::getPotentialMoves(board, pieceOnField, potentialMoves);
+        case Piece::ROOK:
+            return RookRules::getPotentialMoves(board, pieceOnField, potentialMoves);
+        case Piece::KNIGHT:
+            return KnightRules::getPotentialMoves(board, pieceOnField, potentialMoves);
+        case Piece::BISHOP:
+            return BishopRules::getPotentialMoves(board, pieceOnField, potentialMoves);
+        case Piece::QUEEN:
+            return QueenRules::getPotentialMoves(board, pieceOnField, potentialMoves);
+        case Piece::KING:
+            return KingRules::getPotentialMoves(board, pieceOnField, potentialMoves);
+        case Piece::DECOY:
+            return DecoyRules::getPotentialMoves(board, pieceOnField, potentialMoves);
+    }
 }
 
 bool ChessRules::isCastlingLegal(const Board& board, const Move& potentialMove) {
@@ -167,10 +419,13 @@ bool ChessRules::isMoveLegal(const Board& board, const Move& potentialMove) {
     return !wouldMoveSelfIntoCheck(board, potentialMove);
 }
 
-bool ChessRules::applyMove(Board& board, const Move& move, bool assertLegal) {
+template <Color movingColor>
+static bool applyMoveOf(Board& board, const Move& move, bool assertLegal) {
+    using Traits = ColorTraits<movingColor>;
+    using OpponentTraits = ColorTraits<Traits::opponent>;
+    constexpr ChessRank castlingRank = Traits::baseRank;
+
     auto cp = move.getChessPiece();
-    Color movingColor = std::get<ColorIdx>(cp);
-    assert(movingColor == board.whosTurnIsIt());
     auto sf = move.getStartField();
     auto ef = move.getEndField();
     assert(BoardHelper::isInBounds(sf));
@@ -200,94 +455,55 @@ bool ChessRules::applyMove(Board& board, const Move& move, bool assertLegal) {
             return false;
         }
         auto epTargetOpt = board.getPieceOnField(epFieldOpt.value());
-        if (!epTargetOpt.has_value()) {
+        if (!epTargetOpt.has_value() || epTargetOpt.value() != ChessPiece{Traits::opponent, Piece::PAWN}) {
             return false;
         }
-        auto epTarget = epTargetOpt.value();
-        if (std::get<ColorIdx>(epTarget) == movingColor || std::get<PieceIdx>(epTarget) != Piece::PAWN) {
+        board.clearField(epFieldOpt.value());
+    } else if (move.hasModifier(MoveModifier::CASTLING_LONG)) {
+        if (board.getPieceOnField(B, castlingRank).has_value() || board.getPieceOnField(C, castlingRank).has_value() ||
+            board.getPieceOnField(D, castlingRank).has_value()) {
             return false;
         }
-        board.clearField(epFieldOpt.value());
-    } else if (move.hasModifier(MoveModifier::CASTLING_LONG) || move.hasModifier(MoveModifier::CASTLING_SHORT)) {
-        ChessRank castlingRank = (movingColor == Color::WHITE ? 1 : 8);
-
-        if (move.hasModifier(MoveModifier::CASTLING_LONG)) {
-            if (board.getPieceOnField({B, castlingRank}).has_value() || board.getPieceOnField({C, castlingRank}).has_value() ||
-                board.getPieceOnField({D, castlingRank}).has_value()) {
-                return false;
-            }
-
-            if (!board.getPieceOnField({A, castlingRank}).has_value() ||
-                board.getPieceOnField({A, castlingRank}).value() != ChessPiece{movingColor, Piece::ROOK}) {
-                return false;
-            }
-
-            if (!board.getPieceOnField({E, castlingRank}).has_value() ||
-                board.getPieceOnField({E, castlingRank}).value() != ChessPiece{movingColor, Piece::KING}) {
-                return false;
-            }
-            board.clearField({A, castlingRank});
-            board.setField({D, castlingRank}, {movingColor, Piece::ROOK});
-            if (movingColor == Color::WHITE)
-                board.unsetCastling(Board::Castling::WHITE_LONG);
-            else
-                board.unsetCastling(Board::Castling::BLACK_LONG);
-        } else {
-            if (board.getPieceOnField({F, castlingRank}).has_value() || board.getPieceOnField({G, castlingRank}).has_value()) {
-                return false;
-            }
-
-            if (!board.getPieceOnField({H, castlingRank}).has_value() ||
-                board.getPieceOnField({H, castlingRank}).value() != ChessPiece{movingColor, Piece::ROOK}) {
-                return false;
-            }
-
-            if (!board.getPieceOnField({E, castlingRank}).has_value() ||
-                board.getPieceOnField({E, castlingRank}).value() != ChessPiece{movingColor, Piece::KING}) {
-                return false;
-            }
-            board.clearField({H, castlingRank});
-            board.setField({F, castlingRank}, {movingColor, Piece::ROOK});
-            if (movingColor == Color::WHITE)
-                board.unsetCastling(Board::Castling::WHITE_SHORT);
-            else
-                board.unsetCastling(Board::Castling::BLACK_SHORT);
+        if (board.getPieceOnField(A, castlingRank) != ChessPiece{movingColor, Piece::ROOK} ||
+            board.getPieceOnField(E, castlingRank) != ChessPiece{movingColor, Piece::KING}) {
+            return false;
+        }
+        board.clearField({A, castlingRank});
+        board.setField({D, castlingRank}, {movingColor, Piece::ROOK});
+        board.unsetCastling(Traits::castlingLong);
+    } else if (move.hasModifier(MoveModifier::CASTLING_SHORT)) {
+        if (board.getPieceOnField(F, castlingRank).has_value() || board.getPieceOnField(G, castlingRank).has_value()) {
+            return false;
         }
+        if (board.getPieceOnField(H, castlingRank) != ChessPiece{movingColor, Piece::ROOK} ||
+            board.getPieceOnField(E, castlingRank) != ChessPiece{movingColor, Piece::KING}) {
+            return false;
+        }
+        board.clearField({H, castlingRank});
+        board.setField({F, castlingRank}, {movingColor, Piece::ROOK});
+        board.unsetCastling(Traits::castlingShort);
     }
 
     auto piece = std::get<PieceIdx>(cp);
-    auto color = std::get<ColorIdx>(cp);
 
     if (piece == Piece::KING) {
-        if (color == Color::WHITE) {
-            board.unsetCastling(Board::Castling::WHITE_LONG);
-            board.unsetCastling(Board::Castling::WHITE_SHORT);
-        } else {
-            board.unsetCastling(Board::Castling::BLACK_LONG);
-            board.unsetCastling(Board::Castling::BLACK_SHORT);
-        }
+        board.unsetCastling(Traits::castlingLong);
+        board.unsetCastling(Traits::castlingShort);
     } else if (piece == Piece::ROOK) {
-        if (sf == ChessField{A, 1}) {
-            board.unsetCastling(Board::Castling::WHITE_LONG);
-        } else if (sf == ChessField{A, 8}) {
-            board.unsetCastling(Board::Castling::BLACK_LONG);
-        } else if (sf == ChessField{H, 1}) {
-            board.unsetCastling(Board::Castling::WHITE_SHORT);
-        } else if (sf == ChessField{H, 8}) {
-            board.unsetCastling(Board::Castling::BLACK_SHORT);
+        // The other side loses its castling rights when its rook on the corner gets captured, see below
+        if (sf == ChessField{A, castlingRank}) {
+            board.unsetCastling(Traits::castlingLong);
+        } else if (sf == ChessField{H, castlingRank}) {
+            board.unsetCastling(Traits::castlingShort);
         }
     }
 
     if (move.hasModifier(MoveModifier::CAPTURE)) {
         pawnOrCaptureMove = true;
-        if (ef == ChessField{A, 1}) {
-            board.unsetCastling(Board::Castling::WHITE_LONG);
-        } else if (ef == ChessField{H, 1}) {
-            board.unsetCastling(Board::Castling::WHITE_SHORT);
-        } else if (ef == ChessField{A, 8}) {
-            board.unsetCastling(Board::Castling::BLACK_LONG);
-        } else if (ef == ChessField{H, 8}) {
-            board.unsetCastling(Board::Castling::BLACK_SHORT);
+        if (ef == ChessField{A, OpponentTraits::baseRank}) {
+            board.unsetCastling(OpponentTraits::castlingLong);
+        } else if (ef == ChessField{H, OpponentTraits::baseRank}) {
+            board.unsetCastling(OpponentTraits::castlingShort);
         }
     }
 
@@ -302,10 +518,8 @@ bool ChessRules::applyMove(Board& board, const Move& move, bool assertLegal) {
         } else if (move.hasModifier(MoveModifier::PROMOTE_ROOK)) {
             std::get<PieceIdx>(cp) = Piece::ROOK;
         }
-        int distance = std::abs(std::get<ChessRankIdx>(ef) - std::get<ChessRankIdx>(sf));
-        if (distance == 2) {
-            board.setEnPassantTarget(
-                ChessField{std::get<ChessFileIdx>(sf), std::get<ChessRankIdx>(sf) + (movingColor == Color::WHITE ? 1 : -1)});
+        if (std::get<ChessRankIdx>(ef) - std::get<ChessRankIdx>(sf) == 2 * Traits::pawnDirection) {
+            board.setEnPassantTarget(ChessField{std::get<ChessFileIdx>(sf), std::get<ChessRankIdx>(sf) + Traits::pawnDirection});
         } else {
             board.removeEnPassantTarget();
         }
@@ -315,9 +529,9 @@ bool ChessRules::applyMove(Board& board, const Move& move, bool assertLegal) {
 
     board.clearField(sf);
     board.setField(ef, cp);
-    board.setTurn(getOppositeColor(movingColor));
+    board.setTurn(Traits::opponent);
 
-    if (movingColor == Color::BLACK) {
+    if constexpr (!Traits::isWhite) {
         board.incrementFullMove();
     }
 
@@ -334,94 +548,89 @@ bool ChessRules::applyMove(Board& board, const Move& move, bool assertLegal) {
     return true;
 }
 
-// IDEA: Return reason for illegal verdict
-Legality ChessRules::determineBoardPositionLegality(Board& board) {
-    if (board.countAllPieces([](const ChessPiece& cp) { return cp == ChessPiece{Color::WHITE, Piece::KING}; }) != 1)
-        return Legality::ILLEGAL;
-    if (board.countAllPieces([](const ChessPiece& cp) { return cp == ChessPiece{Color::BLACK, Piece::KING}; }) != 1)
-        return Legality::ILLEGAL;
-
-    if (board.countAllPieces([](const ChessPiece& cp) { return cp == ChessPiece{Color::WHITE, Piece::PAWN}; }) > 8)
-        return Legality::ILLEGAL;
-    if (board.countAllPieces([](const ChessPiece& cp) { return cp == ChessPiece{Color::BLACK, Piece::PAWN}; }) > 8)
-        return Legality::ILLEGAL;
-
-    if (board.countAllPieces([](const ChessPiece& cp) { return cp == ChessPiece{Color::WHITE, Piece::BISHOP}; }) > 10)
-        return Legality::ILLEGAL;
-    if (board.countAllPieces([](const ChessPiece& cp) { return cp == ChessPiece{Color::BLACK, Piece::BISHOP}; }) > 10)
-        return Legality::ILLEGAL;
-
-    if (board.countAllPieces([](const ChessPiece& cp) { return cp == ChessPiece{Color::WHITE, Piece::KNIGHT}; }) > 10)
-        return Legality::ILLEGAL;
-    if (board.countAllPieces([](const ChessPiece& cp) { return cp == ChessPiece{Color::BLACK, Piece::KNIGHT}; }) > 10)
-        return Legality::ILLEGAL;
-
-    if (board.countAllPieces([](const ChessPiece& cp) { return cp == ChessPiece{Color::WHITE, Piece::ROOK}; }) > 10)
-        return Legality::ILLEGAL;
-    if (board.countAllPieces([](const ChessPiece& cp) { return cp == ChessPiece{Color::BLACK, Piece::ROOK}; }) > 10)
-        return Legality::ILLEGAL;
-
-    if (board.countAllPieces([](const ChessPiece& cp) { return cp == ChessPiece{Color::WHITE, Piece::QUEEN}; }) > 9)
-        return Legality::ILLEGAL;
-    if (board.countAllPieces([](const ChessPiece& cp) { return cp == ChessPiece{Color::BLACK, Piece::QUEEN}; }) > 9)
-        return Legality::ILLEGAL;
+bool ChessRules::applyMove(Board& board, const Move& move, bool assertLegal) {
+    Color movingColor = std::get<ColorIdx>(move.getChessPiece());
+    assert(movingColor == board.whosTurnIsIt());
+    return dispatchColor(movingColor, [&]<Color color>() { return applyMoveOf<color>(board, move, assertLegal); });
+}
 
-    if (board.countAllPieces([](const ChessPiece& cp) { return std::get<ColorIdx>(cp) == Color::WHITE; }) > 16) return Legality::ILLEGAL;
-    if (board.countAllPieces([](const ChessPiece& cp) { return std::get<ColorIdx>(cp) == Color::BLACK; }) > 16) return Legality::ILLEGAL;
+Legality ChessRules::determineBoardPositionLegality(Board& board) {
+    return findIllegalityReason(board) == IllegalityReason::NONE ? Legality::LEGAL : Legality::ILLEGAL;
+}
 
-    if (board.canCastle(Board::Castling::WHITE_LONG)) {
-        if (!board.getPieceOnField({A, 1}).has_value() || board.getPieceOnField({A, 1}).value() != ChessPiece{Color::WHITE, Piece::ROOK})
-            return Legality::ILLEGAL;
-        if (!board.getPieceOnField({E, 1}).has_value() || board.getPieceOnField({E, 1}).value() != ChessPiece{Color::WHITE, Piece::KING})
-            return Legality::ILLEGAL;
+IllegalityReason ChessRules::findIllegalityReason(const Board& board) {
+    // Indexed by color and piece
+    int counts[2][7] = {};
+    std::optional<Square> kings[2];
+
+    for (int index = 0; index < 64; ++index) {
+        Square square = Square::fromIndex(index);
+        PieceCode cp = board.getPieceCode(square);
+        if (!cp) continue;
+        ++counts[static_cast<int>(cp.color())][static_cast<int>(cp.piece())];
+        if (cp.piece() == Piece::KING) kings[static_cast<int>(cp.color())] = square;
     }
 
-    if (board.canCastle(Board::Castling::WHITE_SHORT)) {
-        if (!board.getPieceOnField({H, 1}).has_value() || board.getPieceOnField({H, 1}).value() != ChessPiece{Color::WHITE, Piece::ROOK})
-            return Legality::ILLEGAL;
-        if (!board.getPieceOnField({E, 1}).has_value() || board.getPieceOnField({E, 1}).value() != ChessPiece{Color::WHITE, Piece::KING})
-            return Legality::ILLEGAL;
-    }
+    for (const auto& count : counts) {
+        auto countOf = [&count](Piece piece) { return count[static_cast<int>(piece)]; };
 
-    if (board.canCastle(Board::Castling::BLACK_LONG)) {
-        if (!board.getPieceOnField({A, 8}).has_value() || board.getPieceOnField({A, 8}).value() != ChessPiece{Color::BLACK, Piece::ROOK})
-            return Legality::ILLEGAL;
-        if (!board.getPieceOnField({E, 8}).has_value() || board.getPieceOnField({E, 8}).value() != ChessPiece{Color::BLACK, Piece::KING})
-            return Legality::ILLEGAL;
+        if (countOf(Piece::KING) != 1) return IllegalityReason::WRONG_NUMBER_OF_KINGS;
+        if (countOf(Piece::PAWN) > 8) return IllegalityReason::TOO_MANY_PAWNS;
+        if (countOf(Piece::BISHOP) > 10 || countOf(Piece::KNIGHT) > 10 || countOf(Piece::ROOK) > 10 || countOf(Piece::QUEEN) > 9)
+            return IllegalityReason::TOO_MANY_PROMOTED_PIECES;
+
+        int total = 0;
+        for (int pieces : count) total += pieces;
+        if (total > 16) return IllegalityReason::TOO_MANY_PIECES;
     }
 
-    if (board.canCastle(Board::Castling::BLACK_SHORT)) {
-        if (!board.getPieceOnField({H, 8}).has_value() || board.getPieceOnField({H, 8}).value() != ChessPiece{Color::BLACK, Piece::ROOK})
-            return Legality::ILLEGAL;
-        if (!board.getPieceOnField({E, 8}).has_value() || board.getPieceOnField({E, 8}).value() != ChessPiece{Color::BLACK, Piece::KING})
-            return Legality::ILLEGAL;
+    for (Color color : {Color::WHITE, Color::BLACK}) {
+        ChessRank rank = (color == Color::WHITE ? 1 : 8);
+        bool canCastleLong = board.canCastle(color == Color::WHITE ? Board::Castling::WHITE_LONG : Board::Castling::BLACK_LONG);
+        bool canCastleShort = board.canCastle(color == Color::WHITE ? Board::Castling::WHITE_SHORT : Board::Castling::BLACK_SHORT);
+        if (!canCastleLong && !canCastleShort) continue;
+
+        if (board.getPieceCode({E, rank}) != PieceCode(ChessPiece{color, Piece::KING})) return IllegalityReason::INVALID_CASTLING;
+        if (canCastleLong && board.getPieceCode({A, rank}) != PieceCode(ChessPiece{color, Piece::ROOK}))
+            return IllegalityReason::INVALID_CASTLING;
+        if (canCastleShort && board.getPieceCode({H, rank}) != PieceCode(ChessPiece{color, Piece::ROOK}))
+            return IllegalityReason::INVALID_CASTLING;
     }
 
     if (board.hasEnPassantTarget()) {
-        auto epField = board.getEnPassantTarget().value();
-        ChessRank rank = std::get<ChessRankIdx>(epField);
-        ChessFile file = std::get<ChessFileIdx>(epField);
-
-        if (rank != 3 && rank != 6)
-            return Legality::ILLEGAL;
-        else if (rank == 3) {
-            if (!board.getPieceOnField({file, 4}).has_value() ||
-                board.getPieceOnField({file, 4}).value() != ChessPiece{Color::WHITE, Piece::PAWN})
-                return Legality::ILLEGAL;
-        } else {
-            if (!board.getPieceOnField({file, 5}).has_value() ||
-                board.getPieceOnField({file, 5}).value() != ChessPiece{Color::BLACK, Piece::PAWN})
-                return Legality::ILLEGAL;
-        }
-    }
+        auto [file, rank] = board.getEnPassantTarget().value();
 
-    auto whiteKing = board.findFirstPiece([](const ChessPiece& cp) { return cp == ChessPiece{Color::WHITE, Piece::KING}; });
-    auto blackKing = board.findFirstPiece([](const ChessPiece& cp) { return cp == ChessPiece{Color::BLACK, Piece::KING}; });
+        // The pawn that just made the double step stands in front of the target
+        if (rank != 3 && rank != 6) return IllegalityReason::INVALID_EN_PASSANT;
+        PieceCode pawn = (rank == 3 ? ChessPiece{Color::WHITE, Piece::PAWN} : ChessPiece{Color::BLACK, Piece::PAWN});
+        if (board.getPieceCode({file, rank == 3 ? 4 : 5}) != pawn) return IllegalityReason::INVALID_EN_PASSANT;
+    }
 
-    int fileDist = std::abs(std::get<ChessFileIdx>(whiteKing.value()) - std::get<ChessFileIdx>(blackKing.value()));
-    int rankDist = std::abs(std::get<ChessRankIdx>(whiteKing.value()) - std::get<ChessRankIdx>(blackKing.value()));
+    int fileDist = std::abs(kings[0]->file() - kings[1]->file());
+    int rankDist = std::abs(kings[0]->rank() - kings[1]->rank());
+    if (fileDist <= 1 && rankDist <= 1) return IllegalityReason::KINGS_ADJACENT;
 
-    if (fileDist <= 1 && rankDist <= 1) return Legality::ILLEGAL;
+    return IllegalityReason::NONE;
+}
 
-    return Legality::LEGAL;
+std::string_view ChessRules::describe(IllegalityReason reason) {
+    switch (reason) {
+        case IllegalityReason::NONE:
+            return "legal";
+        case IllegalityReason::WRONG_NUMBER_OF_KINGS:
+            return "each side needs exactly one king";
+        case IllegalityReason::TOO_MANY_PAWNS:
+            return "more than 8 pawns of one color";
+        case IllegalityReason::TOO_MANY_PROMOTED_PIECES:
+            return "more pieces of one type than promotions allow";
+        case IllegalityReason::TOO_MANY_PIECES:
+            return "more than 16 pieces of one color";
+        case IllegalityReason::INVALID_CASTLING:
+            return "castling rights without king and rook on their start fields";
+        case IllegalityReason::INVALID_EN_PASSANT:
+            return "en-passant target without a pawn that just moved two fields";
+        case IllegalityReason::KINGS_ADJACENT:
+            return "kings on adjacent fields";
+    }
+    return "unknown reason";
 }
@@ -1,17 +1,63 @@
 #pragma once
+#include <string_view>
 #include <vector>
 
 #include "types.h"
 
 class Board;
 class Move;
+class MoveList;
 
 class ChessRules {
    public:
     static std::vector<Move> getAllPotentialMoves(const Board& board);
     static std::vector<Move> getAllValidMoves(const Board& board, bool annotate = true);
+    /**
+     * @brief Appends the potential / valid moves to the list, without allocating
+     *
+     * Moves already in the list are kept untouched, so one list can collect the moves of several calls.
+     */
+    static void getAllPotentialMoves(const Board& board, MoveList& potentialMoves);
+    static void getAllValidMoves(const Board& board, MoveList& validMoves, bool annotate = true);
     static std::vector<Move> getAllValidMoves(const Board& board, ChessField field, bool annotate = true);
-    static void annotateMoves(const Board& board, std::vector<Move>& moves);
+    /**
+     * @brief Marks moves that give check or mate, and on request stale-mate
+     *
+     * A check is detected from the attacks on the king without playing the move. Only moves that give check
+     * are searched for a legal reply to tell check from mate. Stale-mates need that search for every other
+     * move, so they are only marked with withStaleMate, and then only if the king can not simply step aside.
+     */
+    static void annotateMoves(const Board& board, std::vector<Move>& moves, bool withStaleMate = false);
+    static void annotateMoves(const Board& board, MoveList& moves, bool withStaleMate = false);
+
+    /**
+     * @brief Marks moves that give check, without telling mates apart
+     */
+    static void annotateChecks(const Board& board, std::vector<Move>& moves);
+    static void annotateChecks(const Board& board, MoveList& moves);
+    /**
+     * @brief Whether the move gives check, directly or discovered, found from the attacks onto the enemy king
+     */
+    static bool givesCheck(const Board& board, const Move& move);
+
+    /**
+     * @brief Whether and how the game ended, with the valid moves of the side to move as by-product
+     *
+     * The valid moves are generated only once and are not annotated. They are needed anyway to decide
+     * between mate, stale-mate and a running game, so callers that go on playing should use this.
+     *
+     * @param board  The board to evaluate
+     * @param validMoves  Receives all valid moves of the side to move
+     * @return GameStatus ONGOING if the side to move can and may still move
+     */
+    static GameStatus evaluateStatus(const Board& board, std::vector<Move>& validMoves);
+    static GameStatus evaluateStatus(const Board& board, MoveList& validMoves);
+
+    /**
+     * @brief Whether and how the game ended, stops looking for valid moves at the first one
+     */
+    static GameStatus evaluateStatus(const Board& board);
+    static bool hasValidMove(const Board& board);
 
     static bool isGameOver(const Board& board);
     static bool isCheck(const Board& board);
@@ -19,14 +65,27 @@ class ChessRules {
     static bool isStaleMate(const Board& board, bool checkHint = true);
 
     static std::vector<Move> getPotentialMoves(const Board& board, ChessPieceOnField pieceOnField);
+    static void getPotentialMoves(const Board& board, ChessPieceOnField pieceOnField, MoveList& potentialMoves);
     static bool isCastlingLegal(const Board& board, const Move& potentialMove);
     static bool isMoveLegal(const Board& board, const Move& potentialMove);
 
     static bool wouldMoveSelfIntoCheck(const Board& board, const Move& move);
+    /**
+     * @brief Whether a piece of the given color attacks the field, based on the attack patterns of the pieces
+     */
     static bool isFieldCoveredByColor(const Board& board, const ChessField& field, Color color);
 
     static Legality determineBoardPositionLegality(Board& board);
 
+    /**
+     * @brief Why the position is illegal, NONE if it is legal
+     *
+     * Counts all pieces and finds both kings in a single pass over the board, so validating positions in bulk
+     * gets the diagnostics for free.
+     */
+    static IllegalityReason findIllegalityReason(const Board& board);
+    static std::string_view describe(IllegalityReason reason);
+
     /**
      * @brief Applies the requested move. Only very rudimentary checks are applied
      *
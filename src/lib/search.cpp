@@ -0,0 +1,515 @@
+#include "search.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <memory>
+
+#include "move_list.h"
+#include "rules.h"
+#include "zobrist.h"
+
+static constexpr int INFINITE_SCORE = Search::MATE_SCORE + 1;
+static constexpr int MATE_BOUND = Search::MATE_SCORE - Search::MAX_PLY;
+
+// Pawn, Rook, Knight, Bishop, Queen, King, Decoy - in the order of enum Piece
+static constexpr int PieceValues[] = {100, 500, 320, 330, 900, 0, 0};
+
+static int pieceValue(Piece piece) { return PieceValues[static_cast<int>(piece)]; }
+
+/**
+ * @brief Static evaluation from the point of view of the side to move
+ *
+ * Material plus small bonuses for central and far advanced pawns and for centralized minor pieces.
+ */
+static int evaluate(const Board& board) {
+    int score = 0;
+    for (ChessRank rank = 1; rank <= 8; ++rank) {
+        for (ChessFile file = A; file <= H; ++file) {
+            auto cp = board.getPieceOnField(file, rank);
+            if (!cp) continue;
+            Color color = std::get<ColorIdx>(*cp);
+            Piece piece = std::get<PieceIdx>(*cp);
+
+            int value = pieceValue(piece);
+            int centrality = 3 - std::max(std::abs(2 * file - 9), std::abs(2 * rank - 9)) / 2;
+            if (piece == Piece::PAWN) {
+                int advance = (color == Color::WHITE ? rank - 2 : 7 - rank);
+                value += 4 * centrality + 10 * std::max(advance - 2, 0);
+            } else if (piece == Piece::KNIGHT || piece == Piece::BISHOP) {
+                value += 8 * centrality;
+            } else if (piece == Piece::QUEEN) {
+                value += 2 * centrality;
+            }
+            score += (color == Color::WHITE ? value : -value);
+        }
+    }
+    return board.whosTurnIsIt() == Color::WHITE ? score : -score;
+}
+
+static int promotionIndex(const Move& move) {
+    if (move.hasModifier(MoveModifier::PROMOTE_KNIGHT)) return 1;
+    if (move.hasModifier(MoveModifier::PROMOTE_BISHOP)) return 2;
+    if (move.hasModifier(MoveModifier::PROMOTE_ROOK)) return 3;
+    if (move.hasModifier(MoveModifier::PROMOTE_QUEEN)) return 4;
+    return 0;
+}
+
+// 6 bits start field, 6 bits end field, 3 bits promotion. 0 is never a valid move.
+static uint16_t encodeMove(const Move& move) {
+    return static_cast<uint16_t>(BoardHelper::fieldToIndex(move.getStartField()) | (BoardHelper::fieldToIndex(move.getEndField()) << 6) |
+                                 (promotionIndex(move) << 12));
+}
+
+static int moveOrderingScore(const Board& board, const Move& move, uint16_t ttMove) {
+    if (ttMove != 0 && encodeMove(move) == ttMove) return 100000;
+    int score = 0;
+    if (move.hasModifier(MoveModifier::CAPTURE)) {
+        auto victim = board.getPieceOnField(move.getEndField());
+        int victimValue = victim ? pieceValue(std::get<PieceIdx>(*victim)) : pieceValue(Piece::PAWN);
+        score += 10 * victimValue - pieceValue(std::get<PieceIdx>(move.getChessPiece())) + 10000;
+    }
+    if (move.hasModifier(MoveModifier::PROMOTE_QUEEN)) score += 9000;
+    return score;
+}
+
+static void orderMoves(const Board& board, MoveList& moves, uint16_t ttMove) {
+    // Insertion sort keeps equally scored moves in generation order and needs no heap memory
+    std::array<int, MoveList::Capacity> scores;
+    for (size_t i = 0; i < moves.size(); ++i) {
+        Move move = moves[i];
+        int score = moveOrderingScore(board, move, ttMove);
+        size_t j = i;
+        for (; j > 0 && scores[j - 1] < score; --j) {
+            scores[j] = scores[j - 1];
+            moves[j] = moves[j - 1];
+        }
+        scores[j] = score;
+        moves[j] = move;
+    }
+}
+
+// Mate scores are stored relative to the node, not to the root
+static int scoreToTT(int score, int ply) {
+    if (score > MATE_BOUND) return score + ply;
+    if (score < -MATE_BOUND) return score - ply;
+    return score;
+}
+
+static int scoreFromTT(int score, int ply) {
+    if (score > MATE_BOUND) return score - ply;
+    if (score < -MATE_BOUND) return score + ply;
+    return score;
+}
+
+static std::optional<int> mateInMoves(int score) {
+    if (score > MATE_BOUND) return (Search::MATE_SCORE - score + 1) / 2;
+    if (score < -MATE_BOUND) return -(Search::MATE_SCORE + score + 1) / 2;
+    return std::nullopt;
+}
+
+/**
+ * @brief A move at the root of the search together with its latest score and principal variation
+ */
+struct RootMove {
+    explicit RootMove(const Move& move) : move(move), pv(1, move) {}
+
+    Move move;
+    int score = -INFINITE_SCORE;
+    int previousScore = -INFINITE_SCORE;
+    std::vector<Move> pv;
+};
+
+/**
+ * @brief State of one thread taking part in a search
+ *
+ * Thread 0 is the main thread. It checks the limits, searches all MultiPV lines and reports progress.
+ * Helper threads only search the best line and fill the shared transposition table.
+ */
+class SearchThread {
+   public:
+    SearchThread(Search& search, const Board& root, const std::vector<Move>& rootMoves, int id)
+        : _search(search), _root(root), _history(search._history), _id(id) {
+        _history.push(_root);
+        for (const Move& move : rootMoves) _rootMoves.emplace_back(move);
+        if (_id > 0 && !_rootMoves.empty()) {
+            std::rotate(_rootMoves.begin(), _rootMoves.begin() + (_id % _rootMoves.size()), _rootMoves.end());
+        }
+    }
+
+    void iterate(const SearchLimits& limits, const Search::InfoCallback& onInfo) {
+        int maxDepth = (limits.depth > 0 ? std::min(limits.depth, Search::MAX_PLY) : Search::MAX_PLY);
+        size_t lines = (_id == 0 ? std::min<size_t>(_search._multiPV, _rootMoves.size()) : 1);
+
+        for (int depth = 1 + (_id & 1); depth <= maxDepth; ++depth) {
+            for (auto& rootMove : _rootMoves) rootMove.previousScore = rootMove.score;
+
+            for (_pvIdx = 0; _pvIdx < lines && !stopped(); ++_pvIdx) {
+                searchLine(depth);
+            }
+            if (stopped() && _completedDepth > 0) break;
+
+            // Lines are searched best first, but a later line can still end up with a better score
+            std::stable_sort(_rootMoves.begin(), _rootMoves.begin() + lines,
+                             [](const RootMove& a, const RootMove& b) { return a.score > b.score; });
+            _completedDepth = depth;
+            _lines.clear();
+            for (size_t i = 0; i < lines; ++i) _lines.push_back(makeInfo(depth, i));
+
+            if (_id != 0) continue;
+
+            if (onInfo) {
+                for (const auto& info : _lines) onInfo(info);
+            }
+
+            if (stopped()) break;
+            auto mate = mateInMoves(_rootMoves.front().score);
+            if (limits.mate > 0 && mate && *mate > 0 && *mate <= limits.mate) break;
+            if (!limits.infinite && !_search._pondering && _search._softLimit.count() > 0 && _search.elapsed() >= _search._softLimit)
+                break;
+        }
+    }
+
+    SearchResult result() const {
+        SearchResult result;
+        if (_rootMoves.empty()) return result;
+
+        const std::vector<Move>& pv = (_lines.empty() ? _rootMoves.front().pv : _lines.front().pv);
+        result.bestMove = pv.front();
+        if (pv.size() > 1)
+            result.ponderMove = pv[1];
+        else
+            result.ponderMove = ponderMoveFromTT(*result.bestMove);
+
+        result.score = (_lines.empty() ? 0 : _lines.front().score);
+        result.depth = _completedDepth;
+        result.lines = _lines;
+        return result;
+    }
+
+   private:
+    bool stopped() const { return _search._stop.load(std::memory_order_relaxed); }
+
+    SearchInfo makeInfo(int depth, size_t lineIdx) const {
+        const RootMove& rootMove = _rootMoves[lineIdx];
+        SearchInfo info;
+        info.depth = depth;
+        info.multiPv = static_cast<int>(lineIdx) + 1;
+        info.score = rootMove.score;
+        info.mateIn = mateInMoves(rootMove.score);
+        info.nodes = _search._nodes.load(std::memory_order_relaxed);
+        info.time = _search.elapsed();
+        info.pv = rootMove.pv;
+        return info;
+    }
+
+    // The PV can be cut short by a transposition table hit or a stopped iteration
+    std::optional<Move> ponderMoveFromTT(const Move& bestMove) const {
+        Board board(_root);
+        ChessRules::applyMove(board, bestMove);
+        TranspositionTable::Entry entry;
+        if (!_search._tt.probe(Zobrist::hash(board), entry) || entry.move == 0) return std::nullopt;
+
+        for (const Move& move : ChessRules::getAllValidMoves(board, false)) {
+            if (encodeMove(move) == entry.move) return move;
+        }
+        return std::nullopt;
+    }
+
+    void countNode() {
+        ++_localNodes;
+        _search._nodes.fetch_add(1, std::memory_order_relaxed);
+        if (_id == 0 && (_localNodes & 31) == 0) _search.checkLimits();
+    }
+
+    /**
+     * @brief Search the line _pvIdx with an aspiration window around its score of the last iteration
+     *
+     * Every line gets its own window, so a much worse second or third line does not widen the window
+     * of the best one. On a fail low or fail high the window is widened and the line searched again.
+     */
+    void searchLine(int depth) {
+        int previous = _rootMoves[_pvIdx].previousScore;
+        int delta = 40;
+        int alpha = -INFINITE_SCORE;
+        int beta = INFINITE_SCORE;
+        if (depth >= 3 && std::abs(previous) < MATE_BOUND) {
+            alpha = previous - delta;
+            beta = previous + delta;
+        }
+
+        while (true) {
+            int score = searchRoot(depth, alpha, beta);
+            std::stable_sort(_rootMoves.begin() + _pvIdx, _rootMoves.end(),
+                             [](const RootMove& a, const RootMove& b) { return a.score > b.score; });
+            if (stopped()) return;
+
+            if (score <= alpha) {
+                alpha = std::max(score - delta, -INFINITE_SCORE);
+            } else if (score >= beta) {
+                beta = std::min(score + delta, INFINITE_SCORE);
+            } else {
+                return;
+            }
+            delta *= 2;
+        }
+    }
+
+    // Searches all root moves except the ones already chosen for earlier lines
+    int searchRoot(int depth, int alpha, int beta) {
+        int best = -INFINITE_SCORE;
+        std::vector<Move> childPv;
+
+        for (size_t i = _pvIdx; i < _rootMoves.size(); ++i) _rootMoves[i].score = -INFINITE_SCORE;
+
+        for (size_t i = _pvIdx; i < _rootMoves.size(); ++i) {
+            RootMove& rootMove = _rootMoves[i];
+            Board child(_root);
+            ChessRules::applyMove(child, rootMove.move);
+            int score = -alphaBeta(child, depth - 1, -beta, -alpha, 1, childPv);
+            if (stopped()) break;
+
+            rootMove.score = score;
+            if (score > best) {
+                best = score;
+                if (score > alpha || i == _pvIdx) {
+                    rootMove.pv.assign(1, rootMove.move);
+                    rootMove.pv.insert(rootMove.pv.end(), childPv.begin(), childPv.end());
+                }
+                alpha = std::max(alpha, score);
+            }
+            if (alpha >= beta) break;
+        }
+        return best;
+    }
+
+    int alphaBeta(const Board& board, int depth, int alpha, int beta, int ply, std::vector<Move>& pv) {
+        pv.clear();
+        if (depth <= 0) return quiescence(board, alpha, beta, ply);
+
+        countNode();
+        if (stopped()) return 0;
+        if (board.getHalfMoveClock() >= 100) return 0;
+        if (ply >= Search::MAX_PLY) return evaluate(board);
+
+        uint64_t key = Zobrist::hash(board);
+        RepetitionHistory::Guard historyGuard{_history, key, board.getHalfMoveClock()};
+        // Repeating a position gains nothing, the side that repeated first can repeat again for a draw
+        if (_history.countRepetitions() > 0) return 0;
+        TranspositionTable::Entry entry;
+        uint16_t ttMove = 0;
+        if (_search._tt.probe(key, entry)) {
+            ttMove = entry.move;
+            if (entry.depth >= depth) {
+                int ttScore = scoreFromTT(entry.score, ply);
+                if (entry.bound == TranspositionTable::Bound::EXACT ||
+                    (entry.bound == TranspositionTable::Bound::LOWER && ttScore >= beta) ||
+                    (entry.bound == TranspositionTable::Bound::UPPER && ttScore <= alpha))
+                    return ttScore;
+            }
+        }
+
+        MoveList moves;
+        ChessRules::getAllValidMoves(board, moves, false);
+        if (moves.empty()) return ChessRules::isCheck(board) ? -Search::MATE_SCORE + ply : 0;
+        orderMoves(board, moves, ttMove);
+
+        int originalAlpha = alpha;
+        int best = -INFINITE_SCORE;
+        uint16_t bestMove = 0;
+        std::vector<Move> childPv;
+
+        for (const Move& move : moves) {
+            Board child(board);
+            ChessRules::applyMove(child, move);
+            int score = -alphaBeta(child, depth - 1, -beta, -alpha, ply + 1, childPv);
+            if (stopped()) return 0;
+
+            if (score > best) {
+                best = score;
+                bestMove = encodeMove(move);
+                if (score > alpha) {
+                    alpha = score;
+                    pv.assign(1, move);
+                    pv.insert(pv.end(), childPv.begin(), childPv.end());
+                }
+            }
+            if (alpha >= beta) break;
+        }
+
+        auto bound = (best >= beta ? TranspositionTable::Bound::LOWER
+                                   : (best > originalAlpha ? TranspositionTable::Bound::EXACT : TranspositionTable::Bound::UPPER));
+        _search._tt.store(key, depth, scoreToTT(best, ply), bound, bestMove);
+        return best;
+    }
+
+    int quiescence(const Board& board, int alpha, int beta, int ply) {
+        countNode();
+        if (stopped()) return 0;
+
+        int standPat = evaluate(board);
+        if (ply >= Search::MAX_PLY || standPat >= beta) return standPat;
+        alpha = std::max(alpha, standPat);
+
+        MoveList moves;
+        ChessRules::getAllPotentialMoves(board, moves);
+        moves.erase_if([](const Move& move) { return !move.hasModifier(MoveModifier::CAPTURE); });
+        orderMoves(board, moves, 0);
+
+        for (const Move& move : moves) {
+            if (!ChessRules::isMoveLegal(board, move)) continue;
+            Board child(board);
+            ChessRules::applyMove(child, move);
+            int score = -quiescence(child, -beta, -alpha, ply + 1);
+            if (stopped()) return 0;
+
+            if (score >= beta) return score;
+            alpha = std::max(alpha, score);
+        }
+        return alpha;
+    }
+
+    Search& _search;
+    Board _root;
+    RepetitionHistory _history;
+    std::vector<RootMove> _rootMoves;
+    size_t _pvIdx = 0;
+    int _id;
+    uint64_t _localNodes = 0;
+
+    std::vector<SearchInfo> _lines;
+    int _completedDepth = 0;
+};
+
+Search::Search() : _startTime(std::chrono::steady_clock::now()) {}
+
+Search::~Search() {
+    stop();
+    wait();
+}
+
+void Search::setHashSize(size_t megabytes) { _tt.resize(std::max<size_t>(megabytes, 1)); }
+
+void Search::setThreads(int threads) { _threads = std::max(threads, 1); }
+
+void Search::setMultiPV(int lines) { _multiPV = std::max(lines, 1); }
+
+void Search::clearHash() { _tt.clear(); }
+
+void Search::setHistory(const RepetitionHistory& history) { _history = history; }
+
+void Search::start(const Board& board, const SearchLimits& limits, InfoCallback onInfo, ResultCallback onResult) {
+    stop();
+    wait();
+
+    _stop = false;
+    _stopRequested = false;
+    _pondering = limits.ponder;
+    _nodes = 0;
+    _nodeLimit = limits.nodes;
+    _startTime = std::chrono::steady_clock::now();
+    _clockStartTime = _startTime.load();
+
+    using std::chrono::milliseconds;
+    _softLimit = milliseconds{0};
+    _hardLimit = milliseconds{0};
+    Color us = board.whosTurnIsIt();
+    auto clock = (us == Color::WHITE ? limits.whiteTime : limits.blackTime);
+    auto increment = (us == Color::WHITE ? limits.whiteIncrement : limits.blackIncrement);
+    if (limits.infinite) {
+        // No time limits at all
+    } else if (limits.moveTime.count() > 0) {
+        _softLimit = _hardLimit = limits.moveTime;
+    } else if (clock) {
+        // Spread the remaining time over the expected number of moves and keep a safety margin
+        int movesToGo = (limits.movesToGo > 0 ? std::min(limits.movesToGo, 40) : 30);
+        milliseconds available = std::max(*clock - milliseconds{50}, milliseconds{1});
+        _softLimit = std::min(available / movesToGo + increment * 3 / 4, available);
+        _hardLimit = std::min(_softLimit * 4, available / 2 + milliseconds{1});
+        _softLimit = std::min(_softLimit, _hardLimit);
+    }
+
+    _searching = true;
+    _mainThread = std::thread(&Search::searchMain, this, board, limits, std::move(onInfo), std::move(onResult));
+}
+
+SearchResult Search::run(const Board& board, const SearchLimits& limits, InfoCallback onInfo) {
+    SearchResult result;
+    start(board, limits, std::move(onInfo), [&result](const SearchResult& searchResult) { result = searchResult; });
+    wait();
+    return result;
+}
+
+void Search::stop() {
+    {
+        std::lock_guard<std::mutex> lock(_waitMutex);
+        _stopRequested = true;
+        _stop = true;
+    }
+    _waitCondition.notify_all();
+}
+
+void Search::ponderhit() {
+    {
+        std::lock_guard<std::mutex> lock(_waitMutex);
+        _clockStartTime = std::chrono::steady_clock::now();
+        _pondering = false;
+    }
+    _waitCondition.notify_all();
+}
+
+void Search::wait() {
+    if (_mainThread.joinable()) _mainThread.join();
+}
+
+bool Search::isSearching() const { return _searching; }
+
+std::chrono::milliseconds Search::elapsed() const {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - _startTime.load());
+}
+
+std::chrono::milliseconds Search::elapsedOnClock() const {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - _clockStartTime.load());
+}
+
+void Search::checkLimits() {
+    if (_pondering) return;
+    if (_hardLimit.count() > 0 && elapsedOnClock() >= _hardLimit) _stop = true;
+    if (_nodeLimit > 0 && _nodes.load(std::memory_order_relaxed) >= _nodeLimit) _stop = true;
+}
+
+void Search::searchMain(Board board, SearchLimits limits, InfoCallback onInfo, ResultCallback onResult) {
+    std::vector<Move> rootMoves = ChessRules::getAllValidMoves(board, false);
+    if (!limits.searchMoves.empty()) {
+        std::erase_if(rootMoves, [&limits](const Move& move) {
+            return std::find(limits.searchMoves.begin(), limits.searchMoves.end(), move) == limits.searchMoves.end();
+        });
+    }
+
+    SearchResult result;
+    if (!rootMoves.empty()) {
+        std::vector<std::thread> helpers;
+        for (int id = 1; id < _threads; ++id) {
+            helpers.emplace_back([this, &board, &rootMoves, &limits, id]() {
+                SearchThread helper(*this, board, rootMoves, id);
+                helper.iterate(limits, {});
+            });
+        }
+
+        SearchThread mainThread(*this, board, rootMoves, 0);
+        mainThread.iterate(limits, onInfo);
+
+        _stop = true;
+        for (auto& helper : helpers) helper.join();
+        result = mainThread.result();
+    }
+
+    // UCI does not allow sending the result of an infinite search or ponder search before being told so
+    {
+        std::unique_lock<std::mutex> lock(_waitMutex);
+        _waitCondition.wait(lock, [this, &limits]() { return _stopRequested || (!limits.infinite && !_pondering); });
+    }
+
+    _searching = false;
+    if (onResult) onResult(result);
+}
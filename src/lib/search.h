@@ -0,0 +1,152 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "base/helpers.h"
+#include "board.h"
+#include "move.h"
+#include "repetition_history.h"
+#include "transposition_table.h"
+
+/**
+ * @brief Limits of a single search, modelled after the parameters of the UCI "go" command
+ *
+ * Unset clocks and a value of 0 for every other limit mean "no limit".
+ */
+struct SearchLimits {
+    std::optional<std::chrono::milliseconds> whiteTime;
+    std::optional<std::chrono::milliseconds> blackTime;
+    std::chrono::milliseconds whiteIncrement{0};
+    std::chrono::milliseconds blackIncrement{0};
+    std::chrono::milliseconds moveTime{0};
+    int movesToGo = 0;
+    int depth = 0;
+    uint64_t nodes = 0;
+    int mate = 0;
+    bool infinite = false;
+    bool ponder = false;
+    std::vector<Move> searchMoves;
+};
+
+/**
+ * @brief Progress report of a running search, sent for every line after every finished iteration
+ */
+struct SearchInfo {
+    int depth = 0;
+    int multiPv = 1;             // Rank of this line, 1 is the best one
+    int score = 0;               // Centipawns from the point of view of the side to move
+    std::optional<int> mateIn;   // Moves until mate, negative in case the side to move gets mated
+    uint64_t nodes = 0;
+    std::chrono::milliseconds time{0};
+    std::vector<Move> pv;
+};
+
+/**
+ * @brief Final result of a search
+ */
+struct SearchResult {
+    std::optional<Move> bestMove;
+    std::optional<Move> ponderMove;  // Expected reply of the opponent, if known
+    int score = 0;
+    int depth = 0;
+    std::vector<SearchInfo> lines;  // All MultiPV lines of the last finished iteration, best first
+};
+
+/**
+ * @brief Iterative deepening alpha-beta search
+ *
+ * The search runs asynchronously on its own threads, so the caller (e.g. the UCI input loop) stays
+ * responsive and can stop it at any time. With more than one thread, helper threads search the same
+ * position and only share results through the transposition table (lazy SMP).
+ */
+class Search : base::NONCOPYABLE {
+   public:
+    using InfoCallback = std::function<void(const SearchInfo&)>;
+    using ResultCallback = std::function<void(const SearchResult&)>;
+
+    static constexpr int MATE_SCORE = 30000;
+    static constexpr int MAX_PLY = 64;
+
+    Search();
+    ~Search();
+
+    void setHashSize(size_t megabytes);
+    void setThreads(int threads);
+
+    /**
+     * @brief Number of best lines to search and report instead of just the single best move
+     */
+    void setMultiPV(int lines);
+    void clearHash();
+
+    /**
+     * @brief Positions played before the board of the next search, to score repetitions of them as draw
+     *
+     * The board passed to start() must not be part of the history. Takes effect with the next start().
+     */
+    void setHistory(const RepetitionHistory& history);
+
+    /**
+     * @brief Start searching the board in the background
+     *
+     * onInfo is called after every finished iteration, onResult exactly once when the search is done.
+     * Both are called from the search thread. With infinite or ponder limits the result is held back
+     * until stop() or ponderhit() is called, as required by UCI.
+     *
+     * The transposition table is kept between searches, so a ponder search or the search after the
+     * expected reply was played profits from all previous work. Only clearHash() empties it.
+     */
+    void start(const Board& board, const SearchLimits& limits, InfoCallback onInfo, ResultCallback onResult);
+
+    /**
+     * @brief Search the board and block until the result is available
+     */
+    SearchResult run(const Board& board, const SearchLimits& limits, InfoCallback onInfo = {});
+
+    void stop();
+
+    /**
+     * @brief The opponent played the expected move, continue the ponder search as a normal search
+     *
+     * The search is not restarted. Time spent pondering counts as time already thought about the move,
+     * while the hard time limit is measured from now on because only now our clock is running.
+     */
+    void ponderhit();
+    void wait();
+    bool isSearching() const;
+
+   private:
+    friend class SearchThread;
+
+    void searchMain(Board board, SearchLimits limits, InfoCallback onInfo, ResultCallback onResult);
+    void checkLimits();
+    std::chrono::milliseconds elapsed() const;
+    std::chrono::milliseconds elapsedOnClock() const;
+
+    TranspositionTable _tt;
+    RepetitionHistory _history;
+    int _threads = 1;
+    int _multiPV = 1;
+
+    std::thread _mainThread;
+    std::atomic<bool> _searching{false};
+    std::atomic<bool> _stop{false};
+    std::atomic<bool> _stopRequested{false};
+    std::atomic<bool> _pondering{false};
+    std::atomic<uint64_t> _nodes{0};
+    std::atomic<std::chrono::steady_clock::time_point> _startTime;
+    std::atomic<std::chrono::steady_clock::time_point> _clockStartTime;
+    std::chrono::milliseconds _softLimit{0};
+    std::chrono::milliseconds _hardLimit{0};
+    uint64_t _nodeLimit = 0;
+
+    std::mutex _waitMutex;
+    std::condition_variable _waitCondition;
+};
@@ -0,0 +1,77 @@
+#include "self_play.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+void SelfPlayResults::add(GameResult result, uint64_t gamePlies) {
+    switch (result) {
+        case GameResult::WHITE_WINS:
+            ++whiteWins;
+            break;
+        case GameResult::BLACK_WINS:
+            ++blackWins;
+            break;
+        case GameResult::DRAW:
+            ++draws;
+            break;
+        case GameResult::UNDECIDED:
+            ++undecided;
+            break;
+    }
+    plies += gamePlies;
+}
+
+void SelfPlayResults::add(const SelfPlayResults& other) {
+    whiteWins += other.whiteWins;
+    blackWins += other.blackWins;
+    draws += other.draws;
+    undecided += other.undecided;
+    plies += other.plies;
+}
+
+SelfPlay::SelfPlay(PlayerFactory createPlayer, const SelfPlayOptions& options)
+    : _createPlayer(std::move(createPlayer)), _options(options) {}
+
+uint64_t SelfPlay::countPlies(ChessGame& game) { return game.getProgress().getNumberOfMoves(); }
+
+SelfPlayResults SelfPlay::run(const GameCallback& onGameFinished) {
+    unsigned threads = (_options.threads > 0 ? _options.threads : std::max(1u, std::thread::hardware_concurrency()));
+    threads = static_cast<unsigned>(std::clamp(_options.games, 1, static_cast<int>(threads)));
+
+    std::atomic<int> nextGame = 0;
+    std::mutex mutex;
+    std::vector<SelfPlayResults> workerResults(threads);
+
+    auto worker = [&](SelfPlayResults& results) {
+        std::unique_ptr<ChessPlayer> white = _createPlayer(Color::WHITE);
+        std::unique_ptr<ChessPlayer> black = _createPlayer(Color::BLACK);
+
+        for (int gameIndex = nextGame++; gameIndex < _options.games; gameIndex = nextGame++) {
+            uint64_t gameSeed = _options.seed + static_cast<uint64_t>(gameIndex);
+            white->seed(gameSeed);
+            black->seed(gameSeed ^ 0x9E3779B97F4A7C15ull);
+
+            ChessGame game{*white, *black};
+            // Workers run in parallel, so the outcome is left to the serialized callback
+            game.startSyncronousGame(false, false);
+            results.add(game.getResult(), countPlies(game));
+
+            if (onGameFinished) {
+                std::lock_guard lock(mutex);
+                onGameFinished(gameIndex, game);
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned i = 1; i < threads; ++i) workers.emplace_back(worker, std::ref(workerResults[i]));
+    worker(workerResults[0]);
+    for (std::thread& thread : workers) thread.join();
+
+    SelfPlayResults total;
+    for (const SelfPlayResults& results : workerResults) total.add(results);
+    return total;
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include "chess_game.h"
+#include "chess_player.h"
+
+struct SelfPlayOptions {
+    int games = 1;
+    unsigned threads = 0;  ///< 0 means one per hardware thread
+    uint64_t seed = 0;     ///< Game i is played with seed + i, whatever thread plays it
+};
+
+struct SelfPlayResults {
+    int whiteWins = 0;
+    int blackWins = 0;
+    int draws = 0;
+    int undecided = 0;
+    uint64_t plies = 0;
+
+    int games() const { return whiteWins + blackWins + draws + undecided; }
+    void add(GameResult result, uint64_t gamePlies);
+    void add(const SelfPlayResults& other);
+};
+
+/**
+ * @brief Plays a number of games between computer players on a pool of threads
+ *
+ * Every worker creates its own pair of players, so players never have to be thread safe. Before each
+ * game both players are reseeded from the base seed plus the game index, which makes every game
+ * reproducible no matter how many threads run or which thread plays it.
+ */
+class SelfPlay {
+   public:
+    using PlayerFactory = std::function<std::unique_ptr<ChessPlayer>(Color color)>;
+    using GameCallback = std::function<void(int gameIndex, ChessGame& game)>;
+
+    SelfPlay(PlayerFactory createPlayer, const SelfPlayOptions& options);
+
+    /**
+     * @brief Play all games
+     *
+     * @param onGameFinished  Called after every game. Calls are serialized but come from the worker threads
+     *                        and in the order the games finish.
+     * @return SelfPlayResults Results of all games
+     */
+    SelfPlayResults run(const GameCallback& onGameFinished = {});
+
+    /**
+     * @brief Number of plies played in a game
+     */
+    static uint64_t countPlies(ChessGame& game);
+
+   private:
+    PlayerFactory _createPlayer;
+    SelfPlayOptions _options;
+};
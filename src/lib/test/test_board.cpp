@@ -283,3 +283,45 @@ TEST(TestChessBoard, FenStringWithEnPassantTarget) {
     EXPECT_TRUE(debugWrappedApplyMove(board, move));
     EXPECT_EQ(expected, board.getFENString());
 }
+
+TEST(TestChessBoard, Square_ConvertsFromAndToField) {
+    EXPECT_EQ(0, Square(A, 1).index());
+    EXPECT_EQ(7, Square(H, 1).index());
+    EXPECT_EQ(63, Square(H, 8).index());
+
+    for (int index = 0; index < 64; ++index) {
+        Square square = Square::fromIndex(index);
+        ChessField field = square;
+        EXPECT_EQ(square, Square(field));
+        EXPECT_EQ(square.file(), std::get<ChessFileIdx>(field));
+        EXPECT_EQ(square.rank(), std::get<ChessRankIdx>(field));
+    }
+}
+
+TEST(TestChessBoard, PieceCode_ConvertsFromAndToPiece) {
+    static_assert(sizeof(Square) == 1 && sizeof(PieceCode) == 1);
+    EXPECT_TRUE(PieceCode().empty());
+    EXPECT_EQ(std::nullopt, PieceCode().toOptional());
+
+    for (Color color : {Color::WHITE, Color::BLACK}) {
+        for (Piece piece : {Piece::PAWN, Piece::ROOK, Piece::KNIGHT, Piece::BISHOP, Piece::QUEEN, Piece::KING, Piece::DECOY}) {
+            PieceCode code = ChessPiece{color, piece};
+            EXPECT_FALSE(code.empty());
+            EXPECT_EQ(color, code.color());
+            EXPECT_EQ(piece, code.piece());
+            EXPECT_EQ((ChessPiece{color, piece}), static_cast<ChessPiece>(code));
+        }
+    }
+}
+
+TEST(TestChessBoard, GetPieceCode_MatchesGetPieceOnField) {
+    Board board = BoardFactory::createStandardBoard();
+
+    EXPECT_EQ(PieceCode(ChessPiece{Color::WHITE, Piece::KING}), board.getPieceCode({E, 1}));
+    EXPECT_EQ(PieceCode(ChessPiece{Color::BLACK, Piece::QUEEN}), board.getPieceCode({D, 8}));
+    EXPECT_TRUE(board.getPieceCode({E, 4}).empty());
+    for (int index = 0; index < 64; ++index) {
+        Square square = Square::fromIndex(index);
+        EXPECT_EQ(board.getPieceOnField(square), board.getPieceCode(square).toOptional());
+    }
+}
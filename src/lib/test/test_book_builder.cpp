@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+#include "../book_builder.h"
+#include "../opening_book.h"
+#include "../zobrist.h"
+#include "common.h"
+
+static const char* TEST_PGN =
+    "[Result \"1-0\"]\n\n1. e4 e5 2. Nf3 Nc6 1-0\n\n"
+    "[Result \"0-1\"]\n\n1. e4 c5 2. Nf3 d6 0-1\n\n"
+    "[Result \"1/2-1/2\"]\n\n1. d4 d5 1/2-1/2\n\n"
+    "[Result \"*\"]\n\n1. c4 *\n";
+
+TEST(TestBookBuilder, AddPgn_CountsPointsOfMovingSide) {
+    BookBuilder builder(BookBuilderOptions{.maxPly = 2});
+    PgnReader reader(TEST_PGN);
+
+    EXPECT_EQ(3, builder.addPgn(reader));
+
+    auto records = builder.getRecords();
+    EXPECT_TRUE(std::is_sorted(records.begin(), records.end(), [](auto& a, auto& b) { return a.key < b.key; }));
+
+    auto board = debugWrappedGetStdBoard();
+    uint64_t key = Zobrist::hash(board);
+    uint16_t e4 = PolyglotBook::encodeMove(Move{{Color::WHITE, Piece::PAWN}, {E, 2}, {E, 4}});
+    uint16_t d4 = PolyglotBook::encodeMove(Move{{Color::WHITE, Piece::PAWN}, {D, 2}, {D, 4}});
+    // e4 won once and lost once, d4 drew. Higher weights come first.
+    EXPECT_CONTAINS((BookRecord{key, e4, 2}), records);
+    EXPECT_CONTAINS((BookRecord{key, d4, 1}), records);
+    auto first = std::find_if(records.begin(), records.end(), [key](auto& record) { return record.key == key; });
+    EXPECT_EQ(e4, first->move);
+
+    // c5 lost, so it has no weight and is not in the book. Moves beyond the max ply neither.
+    debugWrappedApplyMove(board, Move{{Color::WHITE, Piece::PAWN}, {E, 2}, {E, 4}});
+    key = Zobrist::hash(board);
+    EXPECT_EQ(1, std::count_if(records.begin(), records.end(), [key](auto& record) { return record.key == key; }));
+    EXPECT_EQ(4, records.size());
+}
+
+TEST(TestBookBuilder, Merge_SameAsSingleBuilder) {
+    BookBuilder single;
+    PgnReader all(TEST_PGN);
+    single.addPgn(all);
+
+    BookBuilder first, second;
+    PgnReader firstInput(TEST_PGN);
+    PgnReader secondInput(TEST_PGN);
+    first.addPgn(firstInput);
+    second.addPgn(secondInput);
+    auto merged = BookBuilder::merge({&first, &second}, 4);
+
+    auto expected = single.getRecords();
+    ASSERT_EQ(expected.size(), merged.size());
+    for (size_t i = 0; i < merged.size(); ++i) {
+        EXPECT_EQ(expected[i].key, merged[i].key);
+        EXPECT_EQ(expected[i].move, merged[i].move);
+        EXPECT_EQ(2 * expected[i].weight, merged[i].weight);
+    }
+}
+
+TEST(TestBookBuilder, BuildFromFiles_WrittenBookIsReadable) {
+    auto dir = std::filesystem::temp_directory_path();
+    std::vector<std::string> paths{(dir / "test_book_builder_1.pgn").string(), (dir / "test_book_builder_2.pgn").string()};
+    for (const auto& path : paths) std::ofstream(path) << TEST_PGN;
+    auto bookPath = (dir / "test_book_builder.bin").string();
+
+    size_t games = 0;
+    auto records = BookBuilder::buildFromFiles(paths, BookBuilderOptions{.minGames = 2, .threads = 2}, &games);
+    EXPECT_EQ(6, games);
+    ASSERT_TRUE(BookBuilder::write(bookPath, records));
+
+    PolyglotBook book;
+    ASSERT_TRUE(book.open(bookPath));
+    EXPECT_EQ(records.size(), book.size());
+    auto entries = book.getEntries(debugWrappedGetStdBoard());
+    ASSERT_EQ(2, entries.size());
+    EXPECT_EQ((Move{{Color::WHITE, Piece::PAWN}, {E, 2}, {E, 4}}), entries[0].move);
+    EXPECT_EQ(4, entries[0].weight);
+
+    EXPECT_TRUE(BookBuilder::buildFromFiles({"/this/file/does/not/exist.pgn"}, {}).empty());
+}
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+
+#include "../board.h"
+#include "../board_factory.h"
+#include "../fen.h"
+#include "common.h"
+
+TEST(TestFen, Parse_FullFEN) {
+    Board board;
+    auto result = Fen::parse("rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b Kq e3 7 21", board);
+
+    ASSERT_TRUE(result);
+    EXPECT_EQ((ChessPiece{Color::WHITE, Piece::PAWN}), board.getPieceOnField(E, 4));
+    EXPECT_EQ((ChessPiece{Color::BLACK, Piece::KING}), board.getPieceOnField(E, 8));
+    EXPECT_EQ(std::nullopt, board.getPieceOnField(E, 2));
+    EXPECT_EQ(Color::BLACK, board.whosTurnIsIt());
+    EXPECT_TRUE(board.canCastle(Board::Castling::WHITE_SHORT));
+    EXPECT_FALSE(board.canCastle(Board::Castling::WHITE_LONG));
+    EXPECT_FALSE(board.canCastle(Board::Castling::BLACK_SHORT));
+    EXPECT_TRUE(board.canCastle(Board::Castling::BLACK_LONG));
+    EXPECT_EQ((ChessField{E, 3}), board.getEnPassantTarget());
+    EXPECT_EQ(7, board.getHalfMoveClock());
+    EXPECT_EQ(21, board.getFullMoves());
+}
+
+TEST(TestFen, Parse_OptionalFieldsAndWhitespace) {
+    Board board;
+
+    ASSERT_TRUE(Fen::parse("8/8/8/8/8/8/8/K6k", board));
+    EXPECT_EQ(Color::WHITE, board.whosTurnIsIt());
+
+    ASSERT_TRUE(Fen::parse("  rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR  w   KQkq -\r\n", board));
+    EXPECT_EQ(BoardFactory::createStandardBoard(), board);
+}
+
+TEST(TestFen, Parse_Errors_BoardUnchanged) {
+    Board board = BoardFactory::createStandardBoard();
+    auto expectError = [&board](std::string_view fen, FenError error, size_t position) {
+        auto result = Fen::parse(fen, board);
+        EXPECT_FALSE(result) << fen;
+        EXPECT_EQ(error, result.error) << fen << ": " << Fen::describe(result.error);
+        EXPECT_EQ(position, result.position) << fen;
+    };
+
+    expectError("rnbqkbnr/ppppxppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", FenError::INVALID_PIECE, 13);
+    expectError("rnbqkbnr/ppppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", FenError::RANK_TOO_LONG, 17);
+    expectError("rnbqkbnr/pppppppp/9/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", FenError::INVALID_PIECE, 18);
+    expectError("rnbqkbnr/ppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", FenError::RANK_TOO_SHORT, 16);
+    expectError("rnbqkbnr/pppppppp/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", FenError::WRONG_NUMBER_OF_RANKS, 41);
+    expectError("rnbqkbnr/pppppppp/8/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", FenError::WRONG_NUMBER_OF_RANKS, 36);
+    expectError("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR x KQkq - 0 1", FenError::INVALID_TURN, 44);
+    expectError("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkk - 0 1", FenError::INVALID_CASTLING, 49);
+    expectError("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq e4 0 1", FenError::INVALID_EN_PASSANT, 51);
+    expectError("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - x 1", FenError::INVALID_HALFMOVE_CLOCK, 53);
+    expectError("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 99999999999", FenError::INVALID_FULLMOVE_NUMBER, 55);
+    expectError("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1 x", FenError::TRAILING_CHARACTERS, 57);
+
+    EXPECT_EQ(BoardFactory::createStandardBoard(), board);
+}
+
+TEST(TestFen, Write_RoundTrip) {
+    for (std::string_view fen : {"rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b QKq e3 7 21", "8/8/8/8/8/8/8/K6k w - - 0 4294967295",
+                                 "1r2kb2/5pn1/2n1p1Bp/ppPpq3/7P/1PPPP1PR/1B3P2/1RK3N1 w k b6 0 1"}) {
+        Board board;
+        ASSERT_TRUE(Fen::parse(fen, board));
+
+        Fen::Buffer buffer;
+        EXPECT_EQ(fen, Fen::write(board, buffer, true));
+        std::string_view withoutMoveCount = fen.substr(0, fen.rfind(' ', fen.rfind(' ') - 1));
+        EXPECT_EQ(withoutMoveCount, Fen::write(board, buffer));
+
+        fmt::memory_buffer out;
+        Fen::append(out, board, true);
+        Fen::append(out, board, true);
+        EXPECT_EQ(fmt::format("{}{}", fen, fen), fmt::to_string(out));
+    }
+}
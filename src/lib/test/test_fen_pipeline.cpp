@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include "../fen_pipeline.h"
+
+static std::string createInput(int lines) {
+    const char* fens[] = {"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w QKqk -", "k7/8/8/8/3Pp3/8/8/K7 b - d3",
+                          "rnbqkbnr/ppxppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq -", "4k3/8/8/8/8/8/8/4K3 w - -", "kK6/8/8/8/8/8/8/8 w - -"};
+    std::string input;
+    for (int i = 0; i < lines; ++i) {
+        input += fens[i % 5];
+        input += (i % 7 == 0 ? "\r\n" : "\n");
+    }
+    return input;
+}
+
+static std::string analyzeSequentially(const std::string& input, bool quiet) {
+    fmt::memory_buffer out;
+    std::istringstream in(input);
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        FenPipeline::analyzeLine(line, out, quiet);
+    }
+    return fmt::to_string(out);
+}
+
+TEST(TestFenPipeline, AnalyzeLine_ReportsInvalidFEN) {
+    fmt::memory_buffer out;
+    FenPipeline::analyzeLine("rnbqkbnr/ppxppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq -", out, true);
+
+    EXPECT_EQ("Invalid FEN String rnbqkbnr/ppxppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq -: invalid piece at position 11\n",
+              fmt::to_string(out));
+}
+
+TEST(TestFenPipeline, Run_OutputInInputOrder) {
+    std::string input = createInput(500);
+    std::string expected = analyzeSequentially(input, false);
+
+    // Tiny chunks and a short queue to have lots of chunks in flight and lines crossing chunks
+    FenPipeline pipeline(FenPipelineOptions{.threads = 4, .queueDepth = 3, .chunkSize = 100});
+    std::istringstream in(input);
+    std::ostringstream out;
+
+    EXPECT_EQ(500, pipeline.run(in, out));
+    EXPECT_EQ(expected, out.str());
+}
+
+TEST(TestFenPipeline, Run_LastLineWithoutLineBreakAndEmptyInput) {
+    std::string input = createInput(3) + "4k3/8/8/8/8/8/8/4K3 b - -";
+    FenPipeline pipeline(FenPipelineOptions{.threads = 2, .quiet = true});
+    std::istringstream in(input);
+    std::ostringstream out;
+
+    EXPECT_EQ(4, pipeline.run(in, out));
+    EXPECT_EQ(analyzeSequentially(input, true), out.str());
+
+    std::istringstream empty("");
+    EXPECT_EQ(0, pipeline.run(empty, out));
+}
@@ -0,0 +1,45 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "../game.h"
+
+struct Extra {
+    int value = 0;
+};
+using TestGame = Game<int, char, Extra>;
+
+TEST(TestGame, RootOnly) {
+    TestGame game{42, {7}};
+
+    EXPECT_EQ(1u, game.size());
+    EXPECT_EQ(0u, game.getNumberOfMoves());
+    EXPECT_EQ(42, *game.getCurrentState().content);
+    EXPECT_EQ(7, game.getCurrentState().data->value);
+    EXPECT_EQ(nullptr, game.begin()->moveToNext);
+    EXPECT_EQ(game.end(), ++game.begin());
+}
+
+TEST(TestGame, IterateMovesInOrder) {
+    TestGame game{0, {}};
+    game.reserve(3);
+    game.addMove('a', 1, {10});
+    game.addMove('b', 2, {20});
+    game.addMove('c', 3, {30});
+
+    std::string moves;
+    int expectedState = 0;
+    for (auto state : game) {
+        EXPECT_EQ(expectedState, *state.content);
+        EXPECT_EQ(static_cast<size_t>(expectedState), state.index);
+        EXPECT_EQ(expectedState * 10, state.data->value);
+        if (state.moveToNext) moves += *state.moveToNext;
+        ++expectedState;
+    }
+    EXPECT_EQ("abc", moves);
+    EXPECT_EQ(4, expectedState);
+    EXPECT_EQ(3u, game.getNumberOfMoves());
+    EXPECT_EQ(3, *game.getCurrentState().content);
+    EXPECT_EQ(nullptr, game.getCurrentState().moveToNext);
+    EXPECT_EQ('b', *game.getState(1).moveToNext);
+}
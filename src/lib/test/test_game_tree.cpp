@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "../board_factory.h"
+#include "../chess_game.h"
+#include "../notation.h"
+#include "../rules.h"
+#include "../zobrist.h"
+
+using IntTree = GameTree<int, char, int>;
+
+static std::string childMoves(const IntTree& tree, IntTree::Index node) {
+    std::string moves;
+    for (const auto& edge : tree.getChildren(node)) moves += edge.move;
+    return moves;
+}
+
+TEST(TestGameTree, Variations) {
+    IntTree tree{0, 0};
+    IntTree::Index a = tree.addMove(tree.root(), 'a', 1, 10);
+    IntTree::Index b = tree.addMove(tree.root(), 'b', 2, 20);
+    IntTree::Index aa = tree.addMove(a, 'a', 3, 30);
+
+    EXPECT_EQ(4u, tree.size());
+    EXPECT_EQ(3u, tree.getNumberOfMoves());
+    EXPECT_EQ("ab", childMoves(tree, tree.root()));
+    EXPECT_EQ("a", childMoves(tree, a));
+    EXPECT_EQ("", childMoves(tree, b));
+    EXPECT_EQ(2, tree.getState(b));
+    EXPECT_EQ(30, tree.getData(aa));
+    EXPECT_EQ(a, tree.getParent(aa));
+    EXPECT_EQ(IntTree::Invalid, tree.getParent(tree.root()));
+
+    // Known moves are not added twice
+    EXPECT_EQ(b, tree.addMove(tree.root(), 'b', 5, 50));
+    EXPECT_EQ(4u, tree.size());
+    EXPECT_EQ(b, tree.findChild(tree.root(), 'b'));
+    EXPECT_EQ(IntTree::Invalid, tree.findChild(tree.root(), 'c'));
+
+    EXPECT_EQ((std::vector<IntTree::Index>{tree.root(), a, aa}), tree.getMainLine());
+    EXPECT_EQ((std::vector<IntTree::Index>{b}), tree.getMainLine(b));
+}
+
+TEST(TestGameTree, DeduplicatedCycle) {
+    IntTree tree{0, 0, [](const int& state) { return static_cast<uint64_t>(state % 3); }};
+    IntTree::Index one = tree.addMove(tree.root(), '+', 1, 0);
+    IntTree::Index two = tree.addMove(one, '+', 2, 0);
+    IntTree::Index back = tree.addMove(two, '+', 3, 0);
+
+    EXPECT_EQ(tree.root(), back);
+    EXPECT_EQ(3u, tree.size());
+    EXPECT_EQ(3u, tree.getNumberOfMoves());
+    EXPECT_EQ(3u, tree.getMainLine().size());
+    EXPECT_EQ(two, tree.findNode(2));
+}
+
+static ChessGameTree::Index addSAN(ChessGameTree& tree, ChessGameTree::Index node, std::string_view san) {
+    Board board = tree.getState(node);
+    auto move = Notation::parseSAN(board, san);
+    EXPECT_TRUE(move.has_value());
+    ChessRules::applyMove(board, *move);
+    return tree.addMove(node, *move, board, {});
+}
+
+TEST(TestGameTree, ChessTranspositions) {
+    ChessGameTree tree{BoardFactory::createStandardBoard(), {}, Zobrist::hash};
+
+    ChessGameTree::Index line1 = addSAN(tree, addSAN(tree, addSAN(tree, tree.root(), "e4"), "e5"), "Nf3");
+    ChessGameTree::Index line2 = addSAN(tree, addSAN(tree, addSAN(tree, tree.root(), "Nf3"), "e5"), "e4");
+
+    EXPECT_EQ(line1, line2);
+    EXPECT_EQ(6u, tree.size());
+    EXPECT_EQ(6u, tree.getNumberOfMoves());
+    EXPECT_EQ(2, std::distance(tree.getChildren(tree.root()).begin(), tree.getChildren(tree.root()).end()));
+
+    ChessGameTree plain{BoardFactory::createStandardBoard(), {}};
+    EXPECT_NE(addSAN(plain, addSAN(plain, addSAN(plain, plain.root(), "e4"), "e5"), "Nf3"),
+              addSAN(plain, addSAN(plain, addSAN(plain, plain.root(), "Nf3"), "e5"), "e4"));
+    EXPECT_EQ(7u, plain.size());
+}
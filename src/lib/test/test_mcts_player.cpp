@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include "../board_factory.h"
+#include "../mcts_player.h"
+#include "../move_debug.h"
+#include "../rules.h"
+
+using namespace std::chrono_literals;
+
+TEST(TestMCTSPlayer, FindsMateInOne) {
+    MCTSChessPlayer player{"MCTS", {.playouts = 2000}, 1};
+    Board board = BoardFactory::createBoardFromFEN("k7/8/1K6/8/8/8/8/7Q w - - 0 1");
+
+    Move move = player.getMove(board, ChessRules::getAllValidMoves(board));
+    EXPECT_EQ(ChessField(H, 8), move.getEndField());
+    EXPECT_TRUE(move.hasModifier(MoveModifier::CHECK_MATE));
+}
+
+TEST(TestMCTSPlayer, PlayoutBudget) {
+    MCTSChessPlayer player{"MCTS", {.playouts = 100, .maxPlayoutPlies = 40}, 3};
+    Board board = BoardFactory::createStandardBoard();
+    auto moves = ChessRules::getAllValidMoves(board, false);
+
+    player.getMove(board, moves);
+    EXPECT_EQ(100u, player.getPlayouts());
+    EXPECT_GT(player.getNodes(), moves.size() + 1);
+
+    // A second search starts from scratch
+    player.getMove(board, moves);
+    EXPECT_EQ(100u, player.getPlayouts());
+}
+
+TEST(TestMCTSPlayer, SameSeedSameMove) {
+    Board board = BoardFactory::createBoardFromFEN("r1bqkbnr/pppp1ppp/2n5/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R w KQkq - 2 3");
+    auto moves = ChessRules::getAllValidMoves(board, false);
+    MCTSChessPlayer first{"First", {.playouts = 100, .maxPlayoutPlies = 40}, 4};
+    MCTSChessPlayer second{"Second", {.playouts = 100, .maxPlayoutPlies = 40}, 5};
+    second.seed(4);
+
+    EXPECT_EQ(first.getMove(board, moves), second.getMove(board, moves));
+}
+
+TEST(TestMCTSPlayer, FullTreeAndThreads) {
+    MCTSChessPlayer player{"MCTS", {.playouts = 0, .moveTime = 100ms, .threads = 3, .treeSize = 64}, 6};
+    Board board = BoardFactory::createStandardBoard();
+    auto moves = ChessRules::getAllValidMoves(board, false);
+
+    auto start = std::chrono::steady_clock::now();
+    Move move = player.getMove(board, moves);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 2s);
+    EXPECT_NE(moves.end(), std::find(moves.begin(), moves.end(), move));
+    EXPECT_GT(player.getPlayouts(), 0u);
+    EXPECT_LE(player.getNodes(), 64u);
+}
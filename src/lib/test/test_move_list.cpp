@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+
+#include "../board.h"
+#include "../board_factory.h"
+#include "../move.h"
+#include "../move_list.h"
+#include "../piece_rules.h"
+#include "../rules.h"
+#include "common.h"
+
+TEST(TestMoveList, PushPopAndIndex) {
+    MoveList moves;
+    EXPECT_TRUE(moves.empty());
+
+    moves.push_back(Move({Color::WHITE, Piece::PAWN}, {E, 2}, {E, 4}));
+    moves.emplace_back(ChessPiece{Color::WHITE, Piece::KNIGHT}, ChessField{G, 1}, ChessField{F, 3});
+    ASSERT_EQ(2u, moves.size());
+    EXPECT_EQ((ChessField{F, 3}), moves[1].getEndField());
+
+    moves.pop_back();
+    ASSERT_EQ(1u, moves.size());
+    EXPECT_EQ((ChessField{E, 4}), moves[0].getEndField());
+
+    moves.clear();
+    EXPECT_TRUE(moves.empty());
+}
+
+TEST(TestMoveList, EraseIfKeepsOrder) {
+    MoveList moves;
+    for (ChessFile file = A; file <= H; ++file) moves.push_back(Move({Color::WHITE, Piece::PAWN}, {file, 2}, {file, 3}));
+
+    moves.erase_if([](const Move& move) { return std::get<ChessFileIdx>(move.getStartField()) % 2 == 0; });
+
+    ASSERT_EQ(4u, moves.size());
+    for (size_t i = 0; i < moves.size(); ++i) {
+        EXPECT_EQ(static_cast<ChessFile>(2 * i + 1), std::get<ChessFileIdx>(moves[i].getStartField()));
+    }
+}
+
+TEST(TestMoveList, GeneratorsAppend) {
+    Board board = BoardFactory::createStandardBoard();
+    MoveList moves;
+    moves.push_back(Move({Color::WHITE, Piece::PAWN}, {E, 2}, {E, 4}));
+
+    ChessRules::getAllValidMoves(board, moves);
+
+    ASSERT_EQ(21u, moves.size());
+    EXPECT_EQ((ChessField{E, 2}), moves[0].getStartField());
+}
+
+TEST(TestMoveList, MatchesVectorApi) {
+    Board board = BoardFactory::createBoardFromFEN("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+    MoveList moves;
+
+    ChessRules::getAllValidMoves(board, moves);
+    std::vector<Move> expected = ChessRules::getAllValidMoves(board);
+
+    EXPECT_EQ(48u, moves.size());
+    EXPECT_EQ(expected, moves.toVector());
+}
+
+TEST(TestMoveList, PieceRulesVectorOverloads) {
+    Board board = BoardFactory::createStandardBoard();
+    ChessPieceOnField knight{{Color::WHITE, Piece::KNIGHT}, {G, 1}};
+    MoveList moves;
+
+    KnightRules::getPotentialMoves(board, knight, moves);
+
+    EXPECT_EQ(2u, moves.size());
+    EXPECT_EQ(moves.toVector(), KnightRules::getPotentialMoves(board, knight));
+}
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include "../board.h"
+#include "../move.h"
+#include "../notation.h"
+#include "common.h"
+
+TEST(TestNotation, ParseSAN_PawnAndPieceMoves) {
+    auto board = debugWrappedGetStdBoard();
+
+    EXPECT_EQ((Move{{Color::WHITE, Piece::PAWN}, {E, 2}, {E, 4}}), Notation::parseSAN(board, "e4"));
+    EXPECT_EQ((Move{{Color::WHITE, Piece::KNIGHT}, {G, 1}, {F, 3}}), Notation::parseSAN(board, "Nf3"));
+    EXPECT_EQ((Move{{Color::WHITE, Piece::KNIGHT}, {G, 1}, {F, 3}}), Notation::parseSAN(board, "Ngf3!?"));
+    EXPECT_EQ(std::nullopt, Notation::parseSAN(board, "e5"));
+    EXPECT_EQ(std::nullopt, Notation::parseSAN(board, "Nd4"));
+    EXPECT_EQ(std::nullopt, Notation::parseSAN(board, "xyz"));
+}
+
+TEST(TestNotation, ParseSAN_Disambiguation) {
+    // Knights on b1 and f3 can both reach d2
+    auto board = debugWrappedGetBoardFromFEN("4k3/8/8/8/8/5N2/8/1N2K3 w - - 0 1");
+
+    EXPECT_EQ(std::nullopt, Notation::parseSAN(board, "Nd2"));
+    EXPECT_EQ((Move{{Color::WHITE, Piece::KNIGHT}, {B, 1}, {D, 2}}), Notation::parseSAN(board, "Nbd2"));
+    EXPECT_EQ((Move{{Color::WHITE, Piece::KNIGHT}, {F, 3}, {D, 2}}), Notation::parseSAN(board, "N3d2"));
+}
+
+TEST(TestNotation, ParseSAN_CaptureCastlingPromotion) {
+    auto board = debugWrappedGetBoardFromFEN("r3k3/1P6/8/8/8/8/8/4K2R w K - 0 1");
+
+    auto castling = Notation::parseSAN(board, "O-O+");
+    ASSERT_TRUE(castling.has_value());
+    EXPECT_TRUE(castling->hasModifier(MoveModifier::CASTLING_SHORT));
+    EXPECT_EQ(castling, Notation::parseSAN(board, "0-0"));
+    EXPECT_EQ(std::nullopt, Notation::parseSAN(board, "O-O-O"));
+
+    auto promotion = Notation::parseSAN(board, "bxa8=N");
+    ASSERT_TRUE(promotion.has_value());
+    EXPECT_TRUE(promotion->hasModifier(MoveModifier::PROMOTE_KNIGHT));
+    EXPECT_EQ((ChessField{A, 8}), promotion->getEndField());
+    EXPECT_EQ(promotion, Notation::parseSAN(board, "bxa8N"));
+
+    auto queen = Notation::parseSAN(board, "b8=Q");
+    ASSERT_TRUE(queen.has_value());
+    EXPECT_TRUE(queen->hasModifier(MoveModifier::PROMOTE_QUEEN));
+    // A promotion needs the promotion piece
+    EXPECT_EQ(std::nullopt, Notation::parseSAN(board, "b8"));
+}
+
+TEST(TestNotation, ToSAN_DisambiguationAndSuffixes) {
+    auto board = debugWrappedGetBoardFromFEN("4k3/8/8/8/8/5N2/8/1N2K3 w - - 0 1");
+    EXPECT_EQ("Nbd2", Notation::toSAN(board, Move{{Color::WHITE, Piece::KNIGHT}, {B, 1}, {D, 2}}));
+    EXPECT_EQ("Nd4", Notation::toSAN(board, Move{{Color::WHITE, Piece::KNIGHT}, {F, 3}, {D, 4}}));
+
+    // Rooks on a1 and a5 share the file, so the rank is used
+    board = debugWrappedGetBoardFromFEN("7k/8/8/R7/8/8/8/R3K3 w - - 0 1");
+    EXPECT_EQ("R1a3", Notation::toSAN(board, Move{{Color::WHITE, Piece::ROOK}, {A, 1}, {A, 3}}));
+
+    // Queens on a1, a3 and c1 can all reach c3, the queen on a1 needs file and rank
+    board = debugWrappedGetBoardFromFEN("8/7k/8/8/8/Q7/8/Q1Q1K3 w - - 0 1");
+    EXPECT_EQ("Qa1c3", Notation::toSAN(board, Move{{Color::WHITE, Piece::QUEEN}, {A, 1}, {C, 3}}));
+
+    board = debugWrappedGetBoardFromFEN("r3k3/1P6/8/8/8/8/8/4K2R w K - 0 1");
+    EXPECT_EQ("O-O", Notation::toSAN(board, Move{{Color::WHITE, Piece::KING}, {E, 1}, {G, 1}, {MoveModifier::CASTLING_SHORT}}));
+    EXPECT_EQ("bxa8=Q+", Notation::toSAN(board, Move{{Color::WHITE, Piece::PAWN},
+                                                     {B, 7},
+                                                     {A, 8},
+                                                     {MoveModifier::CAPTURE, MoveModifier::PROMOTE_QUEEN}}));
+
+    board = debugWrappedGetBoardFromFEN("6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1");
+    EXPECT_EQ("Ra8#", Notation::toSAN(board, Move{{Color::WHITE, Piece::ROOK}, {A, 1}, {A, 8}}));
+}
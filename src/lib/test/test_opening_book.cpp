@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <tuple>
+#include <vector>
+
+#include "../board.h"
+#include "../chess_player.h"
+#include "../move.h"
+#include "../opening_book.h"
+#include "../rules.h"
+#include "../uci.h"
+#include "../zobrist.h"
+#include "common.h"
+
+using RawBookEntry = std::tuple<uint64_t, uint16_t, uint16_t>;
+
+static void writeBigEndian(std::ofstream& out, uint64_t value, int bytes) {
+    for (int i = bytes - 1; i >= 0; --i) out.put(static_cast<char>((value >> (8 * i)) & 0xFF));
+}
+
+static std::string writeBook(const std::string& name, std::vector<RawBookEntry> entries) {
+    std::sort(entries.begin(), entries.end());
+    auto path = (std::filesystem::temp_directory_path() / name).string();
+    std::ofstream out(path, std::ios::binary);
+    for (auto& [key, move, weight] : entries) {
+        writeBigEndian(out, key, 8);
+        writeBigEndian(out, move, 2);
+        writeBigEndian(out, weight, 2);
+        writeBigEndian(out, 0, 4);
+    }
+    return path;
+}
+
+TEST(TestOpeningBook, EncodeMove_PolyglotLayout) {
+    // e2e4: to file 4, to row 3, from file 4, from row 1
+    EXPECT_EQ(4 | (3 << 3) | (4 << 6) | (1 << 9), PolyglotBook::encodeMove(Move{{Color::WHITE, Piece::PAWN}, {E, 2}, {E, 4}}));
+    // Castling short is stored as e1h1
+    EXPECT_EQ(7 | (0 << 3) | (4 << 6) | (0 << 9),
+              PolyglotBook::encodeMove(Move{{Color::WHITE, Piece::KING}, {E, 1}, {G, 1}, {MoveModifier::CASTLING_SHORT}}));
+    // Promotion to queen
+    EXPECT_EQ(0 | (7 << 3) | (0 << 6) | (6 << 9) | (4 << 12),
+              PolyglotBook::encodeMove(Move{{Color::WHITE, Piece::PAWN}, {A, 7}, {A, 8}, {MoveModifier::PROMOTE_QUEEN}}));
+}
+
+TEST(TestOpeningBook, ZobristHash_PolyglotReferenceKeys) {
+    // Reference positions and keys from the Polyglot book format specification
+    const std::vector<std::pair<std::string, uint64_t>> positions = {
+        {"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq -", 0x463b96181691fc9c},
+        {"rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3", 0x823c9b50fd114196},
+        {"rnbqkbnr/ppp1pppp/8/3p4/4P3/8/PPPP1PPP/RNBQKBNR w KQkq d6", 0x0756b94461c50fb0},
+        {"rnbqkbnr/ppp1pppp/8/3pP3/8/8/PPPP1PPP/RNBQKBNR b KQkq -", 0x662fafb965db29d4},
+        {"rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6", 0x22a48b5a8e47ff78},
+        {"rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPPKPPP/RNBQ1BNR b kq -", 0x652a607ca3f242c1},
+        {"rnbq1bnr/ppp1pkpp/8/3pPp2/8/8/PPPPKPPP/RNBQ1BNR w - -", 0x00fdd303c946bdd9},
+        {"rnbqkbnr/p1pppppp/8/8/PpP4P/8/1P1PPPP1/RNBQKBNR b KQkq c3", 0x3c8123ea7b067637},
+        {"rnbqkbnr/p1pppppp/8/8/P6P/R1p5/1P1PPPP1/1NBQKBNR b Kkq -", 0x5c3f9b829b279560}};
+
+    for (const auto& [fen, key] : positions) {
+        EXPECT_EQ(key, Zobrist::hash(debugWrappedGetBoardFromFEN(fen))) << fen;
+    }
+}
+
+TEST(TestOpeningBook, ZobristHash_AfterE4_PolyglotReferenceKey) {
+    auto board = debugWrappedGetStdBoard();
+    EXPECT_EQ(0x463b96181691fc9cULL, Zobrist::hash(board));
+
+    ASSERT_TRUE(ChessRules::applyMove(board, Move{{Color::WHITE, Piece::PAWN}, {E, 2}, {E, 4}}));
+    EXPECT_EQ(0x823c9b50fd114196ULL, Zobrist::hash(board));
+}
+
+TEST(TestOpeningBook, Open_MissingFile_False) {
+    PolyglotBook book;
+
+    EXPECT_FALSE(book.open("/this/file/does/not/exist.bin"));
+    EXPECT_FALSE(book.isOpen());
+}
+
+TEST(TestOpeningBook, GetEntries_StandardBoard_AllBookMovesInOrder) {
+    auto board = debugWrappedGetStdBoard();
+    Move e4{{Color::WHITE, Piece::PAWN}, {E, 2}, {E, 4}};
+    Move d4{{Color::WHITE, Piece::PAWN}, {D, 2}, {D, 4}};
+    uint64_t key = Zobrist::hash(board);
+    auto path = writeBook("test_book_entries.bin", {{key - 1, PolyglotBook::encodeMove(d4), 1},
+                                                    {key, PolyglotBook::encodeMove(e4), 10},
+                                                    {key, PolyglotBook::encodeMove(d4), 5},
+                                                    {key + 1, PolyglotBook::encodeMove(e4), 1}});
+    PolyglotBook book(path);
+
+    ASSERT_TRUE(book.isOpen());
+    EXPECT_EQ(4, book.size());
+    auto entries = book.getEntries(board);
+    ASSERT_EQ(2, entries.size());
+    EXPECT_EQ(d4, entries[0].move);
+    EXPECT_EQ(5, entries[0].weight);
+    EXPECT_EQ(e4, entries[1].move);
+    EXPECT_EQ(10, entries[1].weight);
+}
+
+TEST(TestOpeningBook, PickMove_ByWeight) {
+    auto board = debugWrappedGetStdBoard();
+    Move e4{{Color::WHITE, Piece::PAWN}, {E, 2}, {E, 4}};
+    Move d4{{Color::WHITE, Piece::PAWN}, {D, 2}, {D, 4}};
+    uint64_t key = Zobrist::hash(board);
+    auto path = writeBook("test_book_pick.bin", {{key, PolyglotBook::encodeMove(e4), 3}, {key, PolyglotBook::encodeMove(d4), 1}});
+    PolyglotBook book(path);
+
+    // Entries are sorted by move: d4 (weight 1) comes first, then e4 (weight 3)
+    EXPECT_EQ(d4, book.pickMove(board, 0));
+    EXPECT_EQ(e4, book.pickMove(board, 1));
+    EXPECT_EQ(e4, book.pickMove(board, 3));
+    EXPECT_EQ(d4, book.pickMove(board, 4));
+}
+
+TEST(TestOpeningBook, PickMove_UnknownPosition_Nothing) {
+    auto board = debugWrappedGetBoardFromFEN("4k3/8/8/8/8/8/8/4K3 w - -");
+    auto path = writeBook("test_book_unknown.bin", {{1, 0, 1}});
+    PolyglotBook book(path);
+
+    EXPECT_FALSE(book.pickMove(board, 0).has_value());
+}
+
+TEST(TestOpeningBook, BookChessPlayer_PlaysBookMoveThenFallback) {
+    auto board = debugWrappedGetStdBoard();
+    Move e4{{Color::WHITE, Piece::PAWN}, {E, 2}, {E, 4}};
+    auto path = writeBook("test_book_player.bin", {{Zobrist::hash(board), PolyglotBook::encodeMove(e4), 1}});
+    PolyglotBook book(path);
+    PickFirstChessPlayer fallback{"First"};
+    BookChessPlayer player{book, fallback};
+
+    auto moves = debugWrappedGetAllValidMoves(board);
+    EXPECT_EQ("First", player.getName());
+    EXPECT_EQ(e4.getStartField(), player.getMove(board, moves).getStartField());
+    EXPECT_EQ(e4.getEndField(), player.getMove(board, moves).getEndField());
+
+    debugWrappedApplyMove(board, e4);
+    moves = debugWrappedGetAllValidMoves(board);
+    EXPECT_EQ(moves[0], player.getMove(board, moves));
+}
+
+TEST(TestOpeningBook, Uci_OwnBook_AnswersFromBook) {
+    auto board = debugWrappedGetStdBoard();
+    Move a3{{Color::WHITE, Piece::PAWN}, {A, 2}, {A, 3}};
+    auto path = writeBook("test_book_uci.bin", {{Zobrist::hash(board), PolyglotBook::encodeMove(a3), 1}});
+    std::istringstream in("setoption name OwnBook value true\nsetoption name BookFile value " + path + "\nposition startpos\ngo depth 3\n");
+    std::ostringstream out;
+    UciEngine engine(in, out);
+
+    engine.loop();
+
+    EXPECT_EQ("bestmove a2a3\n", out.str());
+}
+
+TEST(TestOpeningBook, Uci_OwnBook_StopsRunningSearchFirst) {
+    auto board = debugWrappedGetStdBoard();
+    Move a3{{Color::WHITE, Piece::PAWN}, {A, 2}, {A, 3}};
+    auto path = writeBook("test_book_uci_ponder.bin", {{Zobrist::hash(board), PolyglotBook::encodeMove(a3), 1}});
+    std::istringstream in;
+    std::ostringstream out;
+    UciEngine engine(in, out);
+
+    engine.handleCommand("setoption name OwnBook value true");
+    engine.handleCommand("setoption name BookFile value " + path);
+    engine.handleCommand("position startpos");
+    engine.handleCommand("go ponder");
+    engine.handleCommand("go depth 3");
+    engine.handleCommand("quit");
+
+    // The ponder search answers once, before the book move, and not again after it
+    std::string output = out.str();
+    size_t bookMove = output.find("bestmove a2a3\n");
+    ASSERT_NE(std::string::npos, bookMove);
+    EXPECT_EQ(output.size(), bookMove + std::string("bestmove a2a3\n").size());
+    EXPECT_LT(output.find("bestmove"), bookMove);
+}
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+
+#include "../board.h"
+#include "../fen.h"
+#include "../packed_position.h"
+#include "common.h"
+
+TEST(TestPackedPosition, PackUnpack_RoundTrip) {
+    for (std::string_view fen : {"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w QKqk - 0 1", "8/8/8/8/8/8/8/K6k b - - 99 300",
+                                 "rnbqkbnr/pppp1ppp/8/8/3Pp3/8/PPP1PPPP/RNBQKBNR b Kq d3 0 3", "8/8/8/8/8/8/8/8 w - - 0 0"}) {
+        Board board;
+        ASSERT_TRUE(Fen::parse(fen, board));
+
+        auto packed = PackedPosition::pack(board);
+        ASSERT_TRUE(packed.has_value()) << fen;
+        Board unpacked = packed->unpack();
+
+        Fen::Buffer buffer;
+        EXPECT_EQ(fen, Fen::write(unpacked, buffer, true));
+        EXPECT_EQ(packed, PackedPosition::pack(unpacked));
+    }
+}
+
+TEST(TestPackedPosition, Pack_Layout) {
+    auto board = debugWrappedGetBoardFromFEN("8/8/8/8/8/8/8/K6k b Q - 300 70000");
+    auto packed = PackedPosition::pack(board);
+    ASSERT_TRUE(packed.has_value());
+
+    // a1 and h1 occupied, white king code 5, black king code 11
+    EXPECT_EQ(0x81, packed->bytes[0]);
+    EXPECT_EQ(0xB5, packed->bytes[8]);
+    EXPECT_EQ(0x01 | 0x04, packed->bytes[24]);
+    EXPECT_EQ(0xFF, packed->bytes[25]);
+    EXPECT_EQ(255, packed->bytes[26]);
+    EXPECT_EQ(0xFF, packed->bytes[27]);
+    EXPECT_EQ(0xFF, packed->bytes[28]);
+}
+
+TEST(TestPackedPosition, PackUnpack_InvalidInput) {
+    // 33 pieces
+    auto board = debugWrappedGetBoardFromFEN("rnbqkbnr/pppppppp/8/8/8/7P/PPPPPPPP/RNBQKBNR w - -");
+    EXPECT_FALSE(PackedPosition::pack(board).has_value());
+
+    PackedPosition packed;
+    packed.bytes[0] = 0x01;
+    packed.bytes[8] = 12;
+    EXPECT_FALSE(PackedPosition::unpack(packed.bytes.data(), board));
+    packed.bytes[8] = 0;
+    packed.bytes[25] = 64;
+    EXPECT_FALSE(PackedPosition::unpack(packed.bytes.data(), board));
+    packed.bytes[25] = 0xFF;
+    EXPECT_TRUE(PackedPosition::unpack(packed.bytes.data(), board));
+    EXPECT_EQ((ChessPiece{Color::WHITE, Piece::PAWN}), board.getPieceOnField(A, 1));
+}
@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+#include "../notation.h"
+#include "../pgn.h"
+#include "common.h"
+
+static const char* TWO_GAMES =
+    "[Event \"Test \\\"Open\\\"\"]\n"
+    "[White \"A\"]\n"
+    "[Black \"B\"]\n"
+    "\n"
+    "1. e4 {best by test} e5 2.Nf3 $1 (2. f4 exf4) Nc6 3... a6 ; comment\n"
+    "1-0\n"
+    "\n"
+    "[Event \"Second\"]\n"
+    "\n"
+    "1. d4 d5 1/2-1/2\n";
+
+TEST(TestPgn, ReadGame_TagsMovesAndResult) {
+    PgnReader reader(TWO_GAMES);
+    PgnGame game;
+
+    ASSERT_TRUE(reader.readGame(game));
+    EXPECT_EQ("Test \\\"Open\\\"", game.getTag("Event"));
+    EXPECT_EQ("B", game.getTag("Black"));
+    EXPECT_EQ(std::nullopt, game.getTag("Site"));
+    EXPECT_EQ((std::vector<std::string_view>{"e4", "e5", "Nf3", "Nc6", "a6"}), game.sanMoves);
+    EXPECT_EQ("1-0", game.result);
+
+    ASSERT_TRUE(reader.readGame(game));
+    EXPECT_EQ("Second", game.getTag("Event"));
+    EXPECT_EQ((std::vector<std::string_view>{"d4", "d5"}), game.sanMoves);
+    EXPECT_EQ("1/2-1/2", game.result);
+
+    EXPECT_FALSE(reader.readGame(game));
+}
+
+TEST(TestPgn, ReadGame_ResolvesMoves) {
+    PgnReader reader("1. e4 e5 2. Nf3 Nf6 3. Bc4 Bc5 4. 0-0 O-O 5. Qe2 Ke7 *");
+    PgnGame game;
+
+    ASSERT_TRUE(reader.readGame(game));
+    EXPECT_EQ("*", game.result);
+    EXPECT_EQ(10, game.sanMoves.size());
+    // Ke7 is not possible after castling
+    EXPECT_EQ(9, game.invalidMove);
+    ASSERT_EQ(9, game.moves.size());
+    EXPECT_EQ((Move{{Color::WHITE, Piece::PAWN}, {E, 2}, {E, 4}}), game.moves[0]);
+    EXPECT_TRUE(game.moves[6].hasModifier(MoveModifier::CASTLING_SHORT));
+    EXPECT_TRUE(game.moves[7].hasModifier(MoveModifier::CASTLING_SHORT));
+}
+
+TEST(TestPgn, ReadGame_FenTagAndResolveLimit) {
+    PgnReader reader(
+        "[SetUp \"1\"]\n[FEN \"4k3/8/8/8/8/8/8/4K2R w K - 0 1\"]\n\n1. O-O Kd7 2. Rd1+ *\n"
+        "1. e4 e5 2. Nf3 *");
+    reader.setResolvePlies(2);
+    PgnGame game;
+
+    ASSERT_TRUE(reader.readGame(game));
+    ASSERT_EQ(2, game.moves.size());
+    EXPECT_TRUE(game.moves[0].hasModifier(MoveModifier::CASTLING_SHORT));
+    EXPECT_EQ(std::nullopt, game.invalidMove);
+
+    ASSERT_TRUE(reader.readGame(game));
+    EXPECT_EQ(3, game.sanMoves.size());
+    EXPECT_EQ(2, game.moves.size());
+}
+
+TEST(TestPgn, Iterator_ReadsAllGamesOfFile) {
+    auto path = (std::filesystem::temp_directory_path() / "test_pgn_iterator.pgn").string();
+    std::ofstream(path) << TWO_GAMES << "\n[Event \"Third\"]\n\n1. c4 0-1";
+
+    PgnReader reader;
+    ASSERT_TRUE(reader.open(path));
+    std::vector<std::string_view> results;
+    for (const PgnGame& game : reader) results.push_back(game.result);
+
+    EXPECT_EQ((std::vector<std::string_view>{"1-0", "1/2-1/2", "0-1"}), results);
+    EXPECT_FALSE(PgnReader().open("/this/file/does/not/exist.pgn"));
+}
+
+TEST(TestPgn, Writer_RoundTripThroughReader) {
+    Board board = debugWrappedGetStdBoard();
+    ChessGameProgress progress(board, {});
+    // Fool's mate
+    for (std::string_view san : {"f3", "e5", "g4", "Qh4#"}) {
+        auto move = Notation::parseSAN(board, san);
+        ASSERT_TRUE(move.has_value());
+        debugWrappedApplyMove(board, *move);
+        progress.addMove(*move, board, {});
+    }
+
+    PgnWriter writer;
+    writer.writeGame(progress, {.event = "Quote \"this\"", .white = "A", .black = "B"});
+    writer.writeGame(progress, {.round = "2", .result = "*"});
+
+    std::string text(writer.getText());
+    EXPECT_NE(std::string::npos, text.find("[Event \"Quote \\\"this\\\"\"]\n[Site \"?\"]\n[Date \"????.??.??\"]\n[Round \"?\"]\n"));
+    EXPECT_NE(std::string::npos, text.find("\n\n1. f3 e5 2. g4 Qh4# 0-1\n\n"));
+
+    PgnReader reader(text);
+    PgnGame game;
+    ASSERT_TRUE(reader.readGame(game));
+    EXPECT_EQ("0-1", game.result);
+    EXPECT_EQ("0-1", game.getTag("Result"));
+    EXPECT_EQ(4, game.moves.size());
+    ASSERT_TRUE(reader.readGame(game));
+    EXPECT_EQ("*", game.result);
+    EXPECT_EQ("2", game.getTag("Round"));
+    EXPECT_FALSE(reader.readGame(game));
+}
+
+TEST(TestPgn, Writer_CustomStartPositionAndLineLength) {
+    Board board = debugWrappedGetBoardFromFEN("4k3/8/8/8/8/8/8/R3K3 b - - 0 12");
+    ChessGameProgress progress(board, {});
+    Move kingMoves[] = {{{Color::BLACK, Piece::KING}, {E, 8}, {D, 8}}, {{Color::WHITE, Piece::KING}, {E, 1}, {E, 2}},
+                        {{Color::BLACK, Piece::KING}, {D, 8}, {E, 8}}, {{Color::WHITE, Piece::KING}, {E, 2}, {E, 1}}};
+    for (int i = 0; i < 10; ++i) {
+        for (const Move& move : kingMoves) {
+            debugWrappedApplyMove(board, move);
+            progress.addMove(move, board, {});
+        }
+    }
+
+    PgnWriter writer;
+    writer.writeGame(progress, {});
+
+    std::string text(writer.getText());
+    EXPECT_NE(std::string::npos, text.find("[SetUp \"1\"]\n[FEN \"4k3/8/8/8/8/8/8/R3K3 b - - 0 12\"]\n"));
+    EXPECT_NE(std::string::npos, text.find("\n\n12... Kd8 13. Ke2 Ke8 14. Ke1 Kd8"));
+    size_t lineStart = 0;
+    for (size_t lineEnd = text.find('\n'); lineEnd != std::string::npos; lineEnd = text.find('\n', lineStart)) {
+        EXPECT_LE(lineEnd - lineStart, 79);
+        lineStart = lineEnd + 1;
+    }
+
+    PgnReader reader(text);
+    PgnGame game;
+    ASSERT_TRUE(reader.readGame(game));
+    EXPECT_EQ(40, game.moves.size());
+    EXPECT_EQ(std::nullopt, game.invalidMove);
+}
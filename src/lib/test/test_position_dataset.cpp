@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#include "../board_factory.h"
+#include "../fen.h"
+#include "../position_dataset.h"
+#include "common.h"
+
+static std::string tempPath(const std::string& name) { return (std::filesystem::temp_directory_path() / name).string(); }
+
+static std::vector<Board> createBoards(int count) {
+    std::vector<Board> boards;
+    Board board = debugWrappedGetStdBoard();
+    for (int i = 0; i < count; ++i) {
+        boards.push_back(board);
+        auto moves = debugWrappedGetAllValidMoves(board);
+        debugWrappedApplyMove(board, moves[i % moves.size()]);
+    }
+    return boards;
+}
+
+TEST(TestPositionDataset, WriteAndRead_RandomAccess) {
+    auto path = tempPath("test_dataset.bin");
+    auto boards = createBoards(20);
+    PositionDatasetWriter writer;
+    ASSERT_TRUE(writer.open(path));
+    for (const Board& board : boards) ASSERT_TRUE(writer.add(board));
+    ASSERT_TRUE(writer.close());
+    EXPECT_EQ(PositionDataset::HeaderSize + 20 * PackedPosition::Size, std::filesystem::file_size(path));
+
+    PositionDataset dataset(path);
+    ASSERT_TRUE(dataset.isOpen());
+    ASSERT_EQ(20, dataset.size());
+    Fen::Buffer expected, actual;
+    for (size_t i : {19, 0, 7}) {
+        EXPECT_EQ(Fen::write(boards[i], expected, true), Fen::write(dataset[i], actual, true));
+    }
+}
+
+TEST(TestPositionDataset, Shards_CoverAllPositionsOnce) {
+    auto path = tempPath("test_dataset_shards.bin");
+    PositionDatasetWriter writer;
+    ASSERT_TRUE(writer.open(path));
+    for (const Board& board : createBoards(10)) writer.add(board);
+    writer.close();
+
+    PositionDataset dataset(path);
+    ASSERT_EQ(10, dataset.size());
+    const size_t shards = 4;
+    std::vector<size_t> visits(dataset.size());
+    std::vector<std::thread> threads;
+    for (size_t shard = 0; shard < shards; ++shard) {
+        threads.emplace_back([&dataset, &visits, shard]() {
+            auto range = dataset.shard(shard, shards);
+            EXPECT_TRUE(range.size() == 2 || range.size() == 3);
+            for (auto it = range.begin(); it != range.end(); ++it) {
+                Board board = *it;
+                EXPECT_TRUE(board.findFirstPiece([](ChessPiece piece) { return std::get<Piece>(piece) == Piece::KING; }).has_value());
+                ++visits[it.index()];
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    EXPECT_EQ(std::vector<size_t>(10, 1), visits);
+}
+
+TEST(TestPositionDataset, Open_RejectsInvalidFiles) {
+    PositionDataset dataset;
+    EXPECT_FALSE(dataset.open("/this/file/does/not/exist.bin"));
+
+    auto path = tempPath("test_dataset_invalid.bin");
+    std::ofstream(path) << "NOTCHESS0000000000000000000000000000000000";
+    EXPECT_FALSE(dataset.open(path));
+
+    // Header claims more records than the file holds
+    PositionDatasetWriter writer;
+    ASSERT_TRUE(writer.open(path));
+    writer.add(*PackedPosition::pack(BoardFactory::createStandardBoard()));
+    writer.close();
+    std::filesystem::resize_file(path, PositionDataset::HeaderSize + 10);
+    EXPECT_FALSE(dataset.open(path));
+    EXPECT_FALSE(dataset.isOpen());
+}
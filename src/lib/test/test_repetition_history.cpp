@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include <string_view>
+
+#include "../board_factory.h"
+#include "../chess_game.h"
+#include "../notation.h"
+#include "../repetition_history.h"
+#include "../rules.h"
+#include "../search.h"
+#include "../zobrist.h"
+
+static void play(Board& board, RepetitionHistory& history, std::initializer_list<std::string_view> sans) {
+    for (std::string_view san : sans) {
+        auto move = Notation::parseSAN(board, san);
+        ASSERT_TRUE(move.has_value()) << san;
+        ChessRules::applyMove(board, *move);
+        history.push(board);
+    }
+}
+
+TEST(TestRepetitionHistory, KnightDance) {
+    Board board = BoardFactory::createStandardBoard();
+    RepetitionHistory history;
+    history.push(board);
+
+    play(board, history, {"Nf3", "Nf6", "Ng1"});
+    EXPECT_EQ(0, history.countRepetitions());
+    play(board, history, {"Ng8"});
+    EXPECT_EQ(1, history.countRepetitions());
+    EXPECT_FALSE(history.isThreefoldRepetition());
+    play(board, history, {"Nf3", "Nf6", "Ng1", "Ng8"});
+    EXPECT_EQ(2, history.countRepetitions());
+    EXPECT_TRUE(history.isThreefoldRepetition());
+
+    history.pop();
+    EXPECT_EQ(5u + 3u, history.size());
+    EXPECT_FALSE(history.isThreefoldRepetition());
+}
+
+TEST(TestRepetitionHistory, IrreversibleMoveEndsTheScan) {
+    Board board = BoardFactory::createStandardBoard();
+    RepetitionHistory history;
+    history.push(board);
+
+    play(board, history, {"Nf3", "Nf6", "Ng1", "Ng8", "e4", "e5"});
+    // Same keys as before the pawn moves can not exist, and the clock stops the scan anyway
+    history.push(0x1234, 0);
+    history.push(0x1234, 0);
+    history.push(0x1234, 0);
+    history.push(0x1234, 0);
+    history.push(0x1234, 3);
+    EXPECT_EQ(0, history.countRepetitions());
+    history.push(0x1234, 4);
+    EXPECT_EQ(1, history.countRepetitions());
+}
+
+TEST(TestRepetitionHistory, SearchAvoidsRepetitionWhenWinning) {
+    Board board = BoardFactory::createBoardFromFEN("7k/8/8/8/8/8/8/K2Q4 w - - 10 40");
+    SearchLimits limits;
+    limits.depth = 3;
+    Search search;
+    SearchResult free = search.run(board, limits);
+    ASSERT_TRUE(free.bestMove.has_value());
+    ASSERT_FALSE(free.bestMove->hasModifier(MoveModifier::CAPTURE));
+
+    // Pretend the position after the best move was already on the board four plies after the root
+    Board repeated = board;
+    ChessRules::applyMove(repeated, *free.bestMove);
+    RepetitionHistory history;
+    history.push(0x1, 6);
+    history.push(Zobrist::hash(repeated), 7);
+    history.push(0x2, 8);
+    history.push(0x3, 9);
+
+    search.clearHash();
+    search.setHistory(history);
+    SearchResult avoided = search.run(board, limits);
+    ASSERT_TRUE(avoided.bestMove.has_value());
+    EXPECT_NE(*free.bestMove, *avoided.bestMove);
+    EXPECT_GT(avoided.score, 0);
+}
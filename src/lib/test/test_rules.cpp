@@ -3,6 +3,7 @@
 #include "../board.h"
 #include "../board_factory.h"
 #include "../move.h"
+#include "../move_debug.h"
 #include "../rules.h"
 #include "common.h"
 
@@ -261,6 +262,10 @@ TEST(TestChessRules, MoveAnnotation_RookCanSetStaleMate_ExpectCorrectMoveAnnotat
     auto board = debugWrappedGetBoardFromFEN("k7/8/1R6/8/8/8/8/1R5K w - -");
     auto moves = debugWrappedGetAllValidMoves(board);
 
+    // Stale-mates are only searched for on request
+    EXPECT_CONTAINS(Move{{Color::WHITE, Piece::ROOK}, {B, 6}, {B, 7}}, moves);
+    moves = ChessRules::getAllValidMoves(board, false);
+    ChessRules::annotateMoves(board, moves, true);
     EXPECT_DOESNOT_CONTAIN(Move{{Color::WHITE, Piece::ROOK}, {B, 6}, {B, 7}}, moves);
     EXPECT_CONTAINS(Move{{Color::WHITE, Piece::ROOK}, {B, 6}, {B, 7}, {MoveModifier::STALE_MATE}}, moves);
 }
@@ -282,4 +287,95 @@ TEST(TestChessRules, GetAllValidMoves_CastlingAvailable_ButPiecesInBetween) {
 
     EXPECT_DOESNOT_CONTAIN(Move{{Color::WHITE, Piece::KING}, {E, 1}, {G, 1}, {MoveModifier::CASTLING_SHORT}}, moves);
     EXPECT_DOESNOT_CONTAIN(Move{{Color::WHITE, Piece::KING}, {E, 1}, {C, 1}, {MoveModifier::CASTLING_LONG}}, moves);
-}
\ No newline at end of file
+}
+
+TEST(TestChessRules, EvaluateStatus_AllStates) {
+    std::vector<Move> moves;
+    auto check = debugWrappedGetBoardFromFEN("4k3/8/8/8/8/8/8/r3K3 w - -");
+    EXPECT_EQ(GameStatus::ONGOING, ChessRules::evaluateStatus(check, moves));
+    EXPECT_EQ(ChessRules::getAllValidMoves(check, false), moves);
+    EXPECT_EQ(GameStatus::ONGOING, ChessRules::evaluateStatus(check));
+
+    auto checkMate = debugWrappedGetBoardFromFEN("4k3/8/8/8/8/8/r7/r3K3 w - -");
+    EXPECT_EQ(GameStatus::CHECK_MATE, ChessRules::evaluateStatus(checkMate, moves));
+    EXPECT_TRUE(moves.empty());
+    EXPECT_EQ(GameStatus::CHECK_MATE, ChessRules::evaluateStatus(checkMate));
+
+    auto staleMate = debugWrappedGetBoardFromFEN("4k1r1/8/8/8/8/8/r7/7K w - -");
+    EXPECT_EQ(GameStatus::STALE_MATE, ChessRules::evaluateStatus(staleMate));
+
+    auto fiftyMoves = debugWrappedGetBoardFromFEN("4k3/8/8/8/8/8/8/r3K3 w - - 51 80");
+    EXPECT_EQ(GameStatus::FIFTY_MOVE_RULE, ChessRules::evaluateStatus(fiftyMoves, moves));
+    EXPECT_FALSE(moves.empty());
+    EXPECT_TRUE(ChessRules::isGameOver(fiftyMoves));
+    EXPECT_FALSE(ChessRules::isGameOver(check));
+}
+
+TEST(TestChessRules, FieldCoveredByColor_AllPieceTypes) {
+    auto board = debugWrappedGetBoardFromFEN("4k3/8/8/3p4/8/1N6/8/R3K2B w - -");
+
+    EXPECT_TRUE(ChessRules::isFieldCoveredByColor(board, {E, 4}, Color::BLACK));   // pawn
+    EXPECT_FALSE(ChessRules::isFieldCoveredByColor(board, {D, 4}, Color::BLACK));  // pawns do not attack straight ahead
+    EXPECT_TRUE(ChessRules::isFieldCoveredByColor(board, {D, 4}, Color::WHITE));   // knight
+    EXPECT_TRUE(ChessRules::isFieldCoveredByColor(board, {A, 8}, Color::WHITE));   // rook
+    EXPECT_TRUE(ChessRules::isFieldCoveredByColor(board, {D, 5}, Color::WHITE));   // bishop up to the first piece
+    EXPECT_FALSE(ChessRules::isFieldCoveredByColor(board, {C, 6}, Color::WHITE));  // but not behind it
+    EXPECT_TRUE(ChessRules::isFieldCoveredByColor(board, {F, 2}, Color::WHITE));   // king
+    EXPECT_FALSE(ChessRules::isFieldCoveredByColor(board, {H, 8}, Color::WHITE));
+}
+
+TEST(TestChessRules, MoveAnnotation_ChecksOnly) {
+    auto board = debugWrappedGetBoardFromFEN("4k3/1R6/8/8/8/8/8/R6K w - -");
+    auto moves = ChessRules::getAllValidMoves(board, false);
+    ChessRules::annotateChecks(board, moves);
+
+    EXPECT_CONTAINS(Move{{Color::WHITE, Piece::ROOK}, {A, 1}, {A, 8}, {MoveModifier::CHECK}}, moves);
+    EXPECT_CONTAINS(Move{{Color::WHITE, Piece::ROOK}, {B, 7}, {E, 7}, {MoveModifier::CHECK}}, moves);
+    EXPECT_CONTAINS(Move{{Color::WHITE, Piece::ROOK}, {A, 1}, {A, 2}}, moves);
+    EXPECT_TRUE(ChessRules::givesCheck(board, Move{{Color::WHITE, Piece::ROOK}, {A, 1}, {E, 1}}));
+    EXPECT_FALSE(ChessRules::givesCheck(board, Move{{Color::WHITE, Piece::ROOK}, {A, 1}, {D, 1}}));
+}
+
+TEST(TestChessRules, GivesCheck_SameAsPlayingTheMove) {
+    // Direct, discovered, en passant, castling and promotion checks
+    const char* fens[] = {"4k3/8/8/8/8/8/8/R3K2R w KQ -",
+                          "4k3/8/8/8/4N3/8/8/4R1K1 w - -",
+                          "8/8/8/k2pP2R/8/8/8/6K1 w - d6",
+                          "3k4/1P6/8/8/8/8/8/6K1 w - -",
+                          "4k3/8/2B5/8/4P3/8/8/4K3 b - -",
+                          "r3k2r/8/8/8/8/8/8/5K2 b kq -",
+                          "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - -",
+                          "r1bqkbnr/pppp1ppp/2n5/4p2Q/2B1P3/8/PPPP1PPP/RNB1K1NR w KQkq -"};
+    for (const char* fen : fens) {
+        auto board = debugWrappedGetBoardFromFEN(fen);
+        for (const Move& move : ChessRules::getAllValidMoves(board, false)) {
+            Board resultingBoard(board);
+            ChessRules::applyMove(resultingBoard, move);
+            EXPECT_EQ(ChessRules::isCheck(resultingBoard), ChessRules::givesCheck(board, move)) << fen << " " << fmt::format("{}", move);
+        }
+    }
+}
+
+TEST(TestChessRules, GetAllValidMovesOfField_OnlyThatPiece) {
+    auto board = debugWrappedGetBoardFromFEN("4k3/1R6/8/8/8/8/8/R6K w - -");
+    auto moves = ChessRules::getAllValidMoves(board, ChessField{A, 1});
+
+    EXPECT_EQ(13u, moves.size());
+    EXPECT_CONTAINS(Move{{Color::WHITE, Piece::ROOK}, {A, 1}, {A, 8}, {MoveModifier::CHECK_MATE}}, moves);
+    EXPECT_TRUE(ChessRules::getAllValidMoves(board, ChessField{E, 8}).empty());
+    EXPECT_TRUE(ChessRules::getAllValidMoves(board, ChessField{E, 4}).empty());
+}
+
+TEST(TestChessRules, FindIllegalityReason) {
+    EXPECT_EQ(IllegalityReason::NONE, ChessRules::findIllegalityReason(debugWrappedGetStdBoard()));
+
+    auto reasonOf = [](const std::string& fen) { return ChessRules::findIllegalityReason(debugWrappedGetBoardFromFEN(fen)); };
+    EXPECT_EQ(IllegalityReason::WRONG_NUMBER_OF_KINGS, reasonOf("8/8/8/8/8/8/8/K7 w - -"));
+    EXPECT_EQ(IllegalityReason::WRONG_NUMBER_OF_KINGS, reasonOf("k6k/8/8/8/8/8/8/K7 w - -"));
+    EXPECT_EQ(IllegalityReason::TOO_MANY_PAWNS, reasonOf("k7/8/8/8/8/1P6/PPPPPPPP/K7 w - -"));
+    EXPECT_EQ(IllegalityReason::TOO_MANY_PROMOTED_PIECES, reasonOf("k7/8/8/8/qqqqqqqq/qq6/8/K7 w - -"));
+    EXPECT_EQ(IllegalityReason::TOO_MANY_PIECES, reasonOf("k7/8/8/8/8/NN6/PPPPPPPP/KNNNNNNN w - -"));
+    EXPECT_EQ(IllegalityReason::INVALID_CASTLING, reasonOf("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBN1 w KQkq -"));
+    EXPECT_EQ(IllegalityReason::INVALID_EN_PASSANT, reasonOf("rnbqkbnr/pppppppp/8/1P6/8/8/P1PPPPPP/RNBQKBNR w KQkq a6"));
+    EXPECT_EQ(IllegalityReason::KINGS_ADJACENT, reasonOf("8/8/8/8/8/8/8/Kk6 w - -"));
+}
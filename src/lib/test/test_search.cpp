@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+
+#include "../board.h"
+#include "../move.h"
+#include "../search.h"
+#include "../transposition_table.h"
+#include "../zobrist.h"
+#include "common.h"
+
+TEST(TestZobrist, SamePosition_SameKey) {
+    auto board = debugWrappedGetStdBoard();
+    auto other = debugWrappedGetBoardFromFEN("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w QKqk -");
+
+    EXPECT_EQ(Zobrist::hash(board), Zobrist::hash(other));
+}
+
+TEST(TestZobrist, DifferentTurn_DifferentKey) {
+    auto white = debugWrappedGetBoardFromFEN("4k3/8/8/8/8/8/8/4K3 w - -");
+    auto black = debugWrappedGetBoardFromFEN("4k3/8/8/8/8/8/8/4K3 b - -");
+
+    EXPECT_NE(Zobrist::hash(white), Zobrist::hash(black));
+}
+
+TEST(TestZobrist, Transposition_SameKey) {
+    auto board1 = debugWrappedGetStdBoard();
+    auto board2 = debugWrappedGetStdBoard();
+
+    debugWrappedApplyMove(board1, Move{{Color::WHITE, Piece::KNIGHT}, {G, 1}, {F, 3}});
+    debugWrappedApplyMove(board1, Move{{Color::BLACK, Piece::KNIGHT}, {G, 8}, {F, 6}});
+    debugWrappedApplyMove(board1, Move{{Color::WHITE, Piece::KNIGHT}, {B, 1}, {C, 3}});
+
+    debugWrappedApplyMove(board2, Move{{Color::WHITE, Piece::KNIGHT}, {B, 1}, {C, 3}});
+    debugWrappedApplyMove(board2, Move{{Color::BLACK, Piece::KNIGHT}, {G, 8}, {F, 6}});
+    debugWrappedApplyMove(board2, Move{{Color::WHITE, Piece::KNIGHT}, {G, 1}, {F, 3}});
+
+    EXPECT_EQ(Zobrist::hash(board1), Zobrist::hash(board2));
+}
+
+TEST(TestTranspositionTable, StoreAndProbe) {
+    TranspositionTable tt(1);
+    TranspositionTable::Entry entry;
+
+    EXPECT_FALSE(tt.probe(0x1234567890ULL, entry));
+    tt.store(0x1234567890ULL, 5, -42, TranspositionTable::Bound::LOWER, 777);
+    ASSERT_TRUE(tt.probe(0x1234567890ULL, entry));
+    EXPECT_EQ(5, entry.depth);
+    EXPECT_EQ(-42, entry.score);
+    EXPECT_EQ(TranspositionTable::Bound::LOWER, entry.bound);
+    EXPECT_EQ(777, entry.move);
+
+    tt.clear();
+    EXPECT_FALSE(tt.probe(0x1234567890ULL, entry));
+}
+
+TEST(TestSearch, MateInOne_Found) {
+    auto board = debugWrappedGetBoardFromFEN("4k3/1R6/8/8/8/8/8/R6K w - -");
+    Search search;
+    SearchLimits limits;
+    limits.depth = 2;
+
+    auto result = search.run(board, limits);
+
+    ASSERT_TRUE(result.bestMove.has_value());
+    EXPECT_EQ((Move{{Color::WHITE, Piece::ROOK}, {A, 1}, {A, 8}}), *result.bestMove);
+    EXPECT_EQ(Search::MATE_SCORE - 1, result.score);
+}
+
+TEST(TestSearch, FreeQueen_Captured) {
+    auto board = debugWrappedGetBoardFromFEN("4k3/8/8/3q4/8/8/3R4/4K3 w - -");
+    Search search;
+    SearchLimits limits;
+    limits.depth = 2;
+
+    auto result = search.run(board, limits);
+
+    ASSERT_TRUE(result.bestMove.has_value());
+    EXPECT_EQ((Move{{Color::WHITE, Piece::ROOK}, {D, 2}, {D, 5}, {MoveModifier::CAPTURE}}), *result.bestMove);
+}
+
+TEST(TestSearch, MultipleThreads_ReportsMove) {
+    auto board = debugWrappedGetStdBoard();
+    Search search;
+    search.setThreads(3);
+    SearchLimits limits;
+    limits.depth = 2;
+    int infos = 0;
+
+    auto result = search.run(board, limits, [&infos](const SearchInfo&) { ++infos; });
+
+    EXPECT_TRUE(result.bestMove.has_value());
+    EXPECT_EQ(2, infos);
+}
+
+TEST(TestSearch, NoValidMoves_NoBestMove) {
+    auto board = debugWrappedGetBoardFromFEN("4k3/8/8/8/8/8/r7/r3K3 w - -");
+    Search search;
+    SearchLimits limits;
+    limits.depth = 3;
+
+    auto result = search.run(board, limits);
+
+    EXPECT_FALSE(result.bestMove.has_value());
+}
+
+TEST(TestSearch, Depth3_PonderMoveKnown) {
+    auto board = debugWrappedGetStdBoard();
+    Search search;
+    SearchLimits limits;
+    limits.depth = 3;
+
+    auto result = search.run(board, limits);
+
+    ASSERT_TRUE(result.bestMove.has_value());
+    ASSERT_TRUE(result.ponderMove.has_value());
+    EXPECT_EQ(Color::BLACK, std::get<ColorIdx>(result.ponderMove->getChessPiece()));
+}
+
+TEST(TestSearch, MultiPV_DistinctLinesBestFirst) {
+    auto board = debugWrappedGetBoardFromFEN("4k3/8/8/3q4/8/8/3R4/4K3 w - -");
+    Search search;
+    search.setMultiPV(3);
+    SearchLimits limits;
+    limits.depth = 2;
+    std::vector<SearchInfo> reported;
+
+    auto result = search.run(board, limits, [&reported](const SearchInfo& info) { reported.push_back(info); });
+
+    ASSERT_EQ(3, result.lines.size());
+    EXPECT_EQ(6, reported.size());
+    EXPECT_EQ((Move{{Color::WHITE, Piece::ROOK}, {D, 2}, {D, 5}, {MoveModifier::CAPTURE}}), result.lines[0].pv.front());
+    EXPECT_EQ(*result.bestMove, result.lines[0].pv.front());
+    for (size_t i = 0; i < result.lines.size(); ++i) {
+        EXPECT_EQ(static_cast<int>(i) + 1, result.lines[i].multiPv);
+        if (i > 0) {
+            EXPECT_GE(result.lines[i - 1].score, result.lines[i].score);
+            EXPECT_NE(result.lines[i - 1].pv.front(), result.lines[i].pv.front());
+        }
+    }
+}
+
+TEST(TestSearch, MultiPV_MoreLinesThanMoves_AllMovesReported) {
+    auto board = debugWrappedGetBoardFromFEN("k7/8/8/8/8/8/8/K7 w - -");
+    Search search;
+    search.setMultiPV(10);
+    SearchLimits limits;
+    limits.depth = 1;
+
+    auto result = search.run(board, limits);
+
+    EXPECT_EQ(3, result.lines.size());
+}
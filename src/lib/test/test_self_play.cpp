@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../board_factory.h"
+#include "../pgn.h"
+#include "../self_play.h"
+#include "../zobrist.h"
+
+static std::unique_ptr<ChessPlayer> createRandomPlayer(Color color) {
+    return std::make_unique<PickRandomChessPlayer>(color == Color::WHITE ? "White" : "Black");
+}
+
+class ScriptedChessPlayer : public ChessPlayer {
+   public:
+    ScriptedChessPlayer(const std::string& name, std::vector<std::pair<ChessField, ChessField>> script)
+        : ChessPlayer(name), _script(std::move(script)) {}
+
+    Move getMove(const Board&, const std::vector<Move>& potentialMoves) override {
+        auto [start, end] = _script.at(_next++);
+        auto it = std::find_if(potentialMoves.begin(), potentialMoves.end(),
+                               [&](const Move& move) { return move.getStartField() == start && move.getEndField() == end; });
+        EXPECT_NE(potentialMoves.end(), it);
+        return *it;
+    }
+
+   private:
+    std::vector<std::pair<ChessField, ChessField>> _script;
+    size_t _next = 0;
+};
+
+static std::map<int, std::string> playGames(unsigned threads, uint64_t seed, SelfPlayResults& results) {
+    std::map<int, std::string> games;
+    SelfPlay selfPlay{createRandomPlayer, {.games = 6, .threads = threads, .seed = seed}};
+    results = selfPlay.run([&games](int gameIndex, ChessGame& game) {
+        PgnWriter writer;
+        writer.writeGame(game.getProgress(), {});
+        games[gameIndex] = writer.getText();
+    });
+    return games;
+}
+
+TEST(TestSelfPlay, Run_SameGamesForAnyNumberOfThreads) {
+    SelfPlayResults single, parallel, otherSeed;
+    auto singleGames = playGames(1, 42, single);
+    auto parallelGames = playGames(3, 42, parallel);
+    auto otherGames = playGames(3, 43, otherSeed);
+
+    EXPECT_EQ(6, single.games());
+    EXPECT_EQ(6, singleGames.size());
+    EXPECT_EQ(singleGames, parallelGames);
+    EXPECT_NE(singleGames, otherGames);
+
+    EXPECT_EQ(single.whiteWins, parallel.whiteWins);
+    EXPECT_EQ(single.blackWins, parallel.blackWins);
+    EXPECT_EQ(single.draws, parallel.draws);
+    EXPECT_EQ(single.plies, parallel.plies);
+    EXPECT_GT(single.plies, 6u);
+    EXPECT_EQ(0, single.undecided);
+}
+
+TEST(TestSelfPlay, PickRandomChessPlayer_SeedReproducesMoves) {
+    PickRandomChessPlayer first{"A", 7}, second{"B", 7};
+    std::vector<Move> moves;
+    for (int i = 0; i < 20; ++i) {
+        moves.emplace_back(ChessPiece{Color::WHITE, Piece::PAWN}, ChessField{A + i % 8, 2}, ChessField{A + i % 8, 3});
+    }
+    auto board = Board{};
+
+    for (int i = 0; i < 10; ++i) EXPECT_EQ(first.getMove(board, moves), second.getMove(board, moves));
+    first.seed(1);
+    second.seed(1);
+    EXPECT_EQ(first.getMove(board, moves), second.getMove(board, moves));
+}
+
+TEST(TestSelfPlay, Playout_SameGameAsSyncronousGame) {
+    PickRandomChessPlayer white{"White", 11}, black{"Black", 12};
+    PlayoutResult playout = ChessGame::playout(BoardFactory::createStandardBoard(), white, black, true);
+
+    white.seed(11);
+    black.seed(12);
+    ChessGame game{white, black};
+    game.startSyncronousGame(false);
+
+    EXPECT_EQ(game.getResult(), playout.result);
+    EXPECT_EQ(SelfPlay::countPlies(game), playout.plies);
+    ASSERT_TRUE(playout.hash.has_value());
+    EXPECT_EQ(Zobrist::hash(game.getBoard()), *playout.hash);
+    EXPECT_FALSE(ChessGame::playout(BoardFactory::createStandardBoard(), white, black).hash.has_value());
+}
+
+TEST(TestSelfPlay, Playout_FinishedPositions) {
+    PickFirstChessPlayer white{"White"}, black{"Black"};
+
+    PlayoutResult mate = ChessGame::playout(BoardFactory::createBoardFromFEN("k7/1Q6/1K6/8/8/8/8/8 b - - 0 1"), white, black);
+    EXPECT_EQ(GameResult::WHITE_WINS, mate.result);
+    EXPECT_EQ(0u, mate.plies);
+
+    PlayoutResult staleMate = ChessGame::playout(BoardFactory::createBoardFromFEN("k7/8/1QK5/8/8/8/8/8 b - - 0 1"), white, black);
+    EXPECT_EQ(GameResult::DRAW, staleMate.result);
+
+    PlayoutResult mateInOne = ChessGame::playout(BoardFactory::createBoardFromFEN("k7/8/1K6/8/8/8/8/7Q w - - 0 1"), white, black);
+    EXPECT_NE(GameResult::UNDECIDED, mateInOne.result);
+    EXPECT_GT(mateInOne.plies, 0u);
+}
+
+TEST(TestSelfPlay, Playout_MateOnLastAllowedPly) {
+    ScriptedChessPlayer white{"White", {{{F, 2}, {F, 3}}, {{G, 2}, {G, 4}}}};
+    ScriptedChessPlayer black{"Black", {{{E, 7}, {E, 5}}, {{D, 8}, {H, 4}}}};
+
+    PlayoutResult foolsMate = ChessGame::playout(BoardFactory::createStandardBoard(), white, black, true, 4);
+
+    EXPECT_EQ(GameResult::BLACK_WINS, foolsMate.result);
+    EXPECT_EQ(4u, foolsMate.plies);
+    EXPECT_TRUE(foolsMate.hash.has_value());
+}
+
+TEST(TestSelfPlay, Playout_MaxPliesStopsOngoingGame) {
+    ScriptedChessPlayer white{"White", {{{F, 2}, {F, 3}}, {{G, 2}, {G, 4}}}};
+    ScriptedChessPlayer black{"Black", {{{E, 7}, {E, 5}}, {{D, 8}, {H, 4}}}};
+
+    PlayoutResult capped = ChessGame::playout(BoardFactory::createStandardBoard(), white, black, false, 3);
+
+    EXPECT_EQ(GameResult::UNDECIDED, capped.result);
+    EXPECT_EQ(3u, capped.plies);
+}
+
+TEST(TestSelfPlay, SyncronousGame_QuietStillPrintsResult) {
+    ScriptedChessPlayer white{"White", {{{F, 2}, {F, 3}}, {{G, 2}, {G, 4}}}};
+    ScriptedChessPlayer black{"Black", {{{E, 7}, {E, 5}}, {{D, 8}, {H, 4}}}};
+    ChessGame game{white, black};
+
+    testing::internal::CaptureStdout();
+    game.startSyncronousGame(false);
+    std::string output = testing::internal::GetCapturedStdout();
+
+    EXPECT_EQ(0u, output.find("rnb1kbnr/pppp1ppp/8/4p3/6Pq/5P2/PPPPP2P/RNBQKBNR w "));
+    EXPECT_NE(std::string::npos, output.find("\nWhite is check-mate Black won\n"));
+    EXPECT_EQ(GameResult::BLACK_WINS, game.getResult());
+}
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <sstream>
+#include <thread>
+
+#include "../board.h"
+#include "../board_factory.h"
+#include "../move.h"
+#include "../uci.h"
+#include "common.h"
+
+TEST(TestUci, MoveToString_Promotion) {
+    Move move({Color::WHITE, Piece::PAWN}, {E, 7}, {E, 8}, {MoveModifier::PROMOTE_QUEEN});
+
+    EXPECT_EQ("e7e8q", UciEngine::moveToString(move));
+}
+
+TEST(TestUci, MoveToString_Castling) {
+    Move move({Color::WHITE, Piece::KING}, {E, 1}, {G, 1}, {MoveModifier::CASTLING_SHORT});
+
+    EXPECT_EQ("e1g1", UciEngine::moveToString(move));
+}
+
+TEST(TestUci, ParseMove_InvalidMove_Nothing) {
+    auto board = debugWrappedGetStdBoard();
+
+    EXPECT_FALSE(UciEngine::parseMove(board, "e2e5").has_value());
+    EXPECT_TRUE(UciEngine::parseMove(board, "e2e4").has_value());
+}
+
+TEST(TestUci, Uci_Handshake) {
+    std::istringstream in("uci\nisready\nquit\n");
+    std::ostringstream out;
+    UciEngine engine(in, out);
+
+    engine.loop();
+
+    EXPECT_NE(std::string::npos, out.str().find("id name"));
+    EXPECT_NE(std::string::npos, out.str().find("option name Hash"));
+    EXPECT_NE(std::string::npos, out.str().find("uciok\nreadyok\n"));
+}
+
+TEST(TestUci, Position_StartposWithMoves) {
+    std::istringstream in;
+    std::ostringstream out;
+    UciEngine engine(in, out);
+
+    engine.handleCommand("position startpos moves e2e4 e7e5 g1f3");
+
+    auto expected = debugWrappedGetBoardFromFEN("rnbqkbnr/pppp1ppp/8/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R b KQkq -");
+    EXPECT_EQ(expected, engine.getBoard());
+}
+
+TEST(TestUci, Position_FenWithUnknownLeadingToken) {
+    std::istringstream in;
+    std::ostringstream out;
+    UciEngine engine(in, out);
+
+    engine.handleCommand("joho position fen 4k3/8/8/8/8/8/8/R3K3 w Q - 0 1 moves e1c1");
+
+    auto expected = debugWrappedGetBoardFromFEN("4k3/8/8/8/8/8/8/2KR4 b - -");
+    EXPECT_EQ(expected, engine.getBoard());
+}
+
+TEST(TestUci, Position_IllegalFen_KeepsPreviousPosition) {
+    std::istringstream in("position startpos moves e2e4\nposition fen QQQQQQQQ/8/8/8/8/8/8/QQQQQQQk w - - 0 1\ngo depth 1\n");
+    std::ostringstream out;
+    UciEngine engine(in, out);
+
+    engine.loop();
+
+    EXPECT_NE(std::string::npos, out.str().find("info string illegal position: each side needs exactly one king"));
+    EXPECT_NE(std::string::npos, out.str().find("bestmove"));
+    auto expected = debugWrappedGetBoardFromFEN("rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3");
+    EXPECT_EQ(expected, engine.getBoard());
+}
+
+TEST(TestUci, Position_IllegalMove_KeepsPreviousPosition) {
+    std::istringstream in;
+    std::ostringstream out;
+    UciEngine engine(in, out);
+
+    engine.handleCommand("position startpos moves e2e4");
+    engine.handleCommand("position startpos moves d2d4 d7d5 e1e3");
+
+    EXPECT_NE(std::string::npos, out.str().find("info string illegal move e1e3"));
+    auto expected = debugWrappedGetBoardFromFEN("rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3");
+    EXPECT_EQ(expected, engine.getBoard());
+}
+
+TEST(TestUci, GoDepth_SendsBestMove) {
+    std::istringstream in("position fen 4k3/1R6/8/8/8/8/8/R6K w - - 0 1\ngo depth 2\n");
+    std::ostringstream out;
+    UciEngine engine(in, out);
+
+    engine.loop();
+
+    EXPECT_NE(std::string::npos, out.str().find("score mate 1"));
+    EXPECT_NE(std::string::npos, out.str().find("bestmove a1a8"));
+}
+
+TEST(TestUci, GoInfinite_BestMoveOnlyAfterStop) {
+    std::istringstream in;
+    std::ostringstream out;
+    UciEngine engine(in, out);
+
+    engine.handleCommand("position startpos");
+    engine.handleCommand("go infinite");
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    engine.handleCommand("isready");
+    engine.handleCommand("stop");
+    engine.handleCommand("quit");
+
+    EXPECT_NE(std::string::npos, out.str().find("readyok"));
+    EXPECT_LT(out.str().find("readyok"), out.str().find("bestmove"));
+}
+
+TEST(TestUci, GoPonder_BestMoveWithPonderMoveOnlyAfterPonderhit) {
+    std::istringstream in;
+    std::ostringstream out;
+    UciEngine engine(in, out);
+
+    engine.handleCommand("position startpos moves e2e4 e7e5");
+    engine.handleCommand("go ponder movetime 50");
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    engine.handleCommand("isready");
+    engine.handleCommand("ponderhit");
+    engine.handleCommand("quit");
+
+    EXPECT_LT(out.str().find("readyok"), out.str().find("bestmove"));
+    EXPECT_NE(std::string::npos, out.str().find(" ponder "));
+}
+
+TEST(TestUci, MultiPV_InfoPerLine) {
+    std::istringstream in("setoption name MultiPV value 2\nposition startpos\ngo depth 1\n");
+    std::ostringstream out;
+    UciEngine engine(in, out);
+
+    engine.loop();
+
+    EXPECT_NE(std::string::npos, out.str().find("info depth 1 multipv 1 "));
+    EXPECT_NE(std::string::npos, out.str().find("info depth 1 multipv 2 "));
+    EXPECT_EQ(std::string::npos, out.str().find("multipv 3"));
+}
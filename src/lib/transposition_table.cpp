@@ -0,0 +1,56 @@
+#include "transposition_table.h"
+
+static uint64_t packEntry(const TranspositionTable::Entry& entry) {
+    return static_cast<uint64_t>(static_cast<uint16_t>(entry.score)) | (static_cast<uint64_t>(static_cast<uint8_t>(entry.depth)) << 16) |
+           (static_cast<uint64_t>(entry.bound) << 24) | (static_cast<uint64_t>(entry.move) << 32);
+}
+
+static TranspositionTable::Entry unpackEntry(uint64_t data) {
+    TranspositionTable::Entry entry;
+    entry.score = static_cast<int16_t>(data & 0xFFFF);
+    entry.depth = static_cast<int8_t>((data >> 16) & 0xFF);
+    entry.bound = static_cast<TranspositionTable::Bound>((data >> 24) & 0xFF);
+    entry.move = static_cast<uint16_t>((data >> 32) & 0xFFFF);
+    return entry;
+}
+
+TranspositionTable::TranspositionTable(size_t megabytes) { resize(megabytes); }
+
+void TranspositionTable::resize(size_t megabytes) {
+    size_t slots = (megabytes * 1024 * 1024) / sizeof(Slot);
+    // Round down to a power of two so the index is a simple mask
+    size_t size = 1;
+    while (size * 2 <= slots) size *= 2;
+    _slots = std::make_unique<Slot[]>(size);
+    _size = size;
+}
+
+void TranspositionTable::clear() {
+    for (size_t i = 0; i < _size; ++i) {
+        _slots[i].keyXorData.store(0, std::memory_order_relaxed);
+        _slots[i].data.store(0, std::memory_order_relaxed);
+    }
+}
+
+bool TranspositionTable::probe(uint64_t key, Entry& entry) const {
+    const Slot& slot = _slots[key & (_size - 1)];
+    uint64_t data = slot.data.load(std::memory_order_relaxed);
+    if ((slot.keyXorData.load(std::memory_order_relaxed) ^ data) != key) return false;
+    entry = unpackEntry(data);
+    return entry.bound != Bound::NONE;
+}
+
+void TranspositionTable::store(uint64_t key, int depth, int score, Bound bound, uint16_t move) {
+    Slot& slot = _slots[key & (_size - 1)];
+    uint64_t oldData = slot.data.load(std::memory_order_relaxed);
+    bool sameKey = (slot.keyXorData.load(std::memory_order_relaxed) ^ oldData) == key;
+    Entry old = unpackEntry(oldData);
+
+    // Prefer deeper results of the same position but always replace entries of other positions
+    if (sameKey && bound != Bound::EXACT && old.depth > depth) return;
+    if (sameKey && move == 0) move = old.move;
+
+    uint64_t data = packEntry({static_cast<int16_t>(score), static_cast<int8_t>(depth), bound, move});
+    slot.keyXorData.store(key ^ data, std::memory_order_relaxed);
+    slot.data.store(data, std::memory_order_relaxed);
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "base/helpers.h"
+
+/**
+ * @brief Shared hash table for search results
+ *
+ * Fixed size table of search results indexed by Zobrist key. It is shared between all search threads
+ * without locks: every slot stores the key XOR-ed with its data, so torn writes from concurrent threads
+ * are detected on probe and simply treated as a miss.
+ */
+class TranspositionTable : base::NONCOPYABLE {
+   public:
+    enum class Bound : uint8_t { NONE, UPPER, LOWER, EXACT };
+
+    struct Entry {
+        int16_t score = 0;
+        int8_t depth = 0;
+        Bound bound = Bound::NONE;
+        uint16_t move = 0;
+    };
+
+    explicit TranspositionTable(size_t megabytes = 16);
+
+    /**
+     * @brief Reallocate the table with the given size. All stored entries are lost.
+     */
+    void resize(size_t megabytes);
+    void clear();
+
+    bool probe(uint64_t key, Entry& entry) const;
+    void store(uint64_t key, int depth, int score, Bound bound, uint16_t move);
+
+    size_t size() const { return _size; }
+
+   private:
+    struct Slot {
+        std::atomic<uint64_t> keyXorData{0};
+        std::atomic<uint64_t> data{0};
+    };
+
+    std::unique_ptr<Slot[]> _slots;
+    size_t _size = 0;
+};
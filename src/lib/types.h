@@ -1,4 +1,7 @@
 #pragma once
+#include <cassert>
+#include <cstdint>
+#include <optional>
 #include <tuple>
 
 /**
@@ -13,6 +16,22 @@ enum class Piece { PAWN, ROOK, KNIGHT, BISHOP, QUEEN, KING, DECOY };
 
 enum class Legality { UNDETERMINED, LEGAL, ILLEGAL };
 
+/**
+ * @brief The first rule an illegal position violates, NONE for legal positions
+ */
+enum class IllegalityReason {
+    NONE,
+    WRONG_NUMBER_OF_KINGS,
+    TOO_MANY_PAWNS,
+    TOO_MANY_PROMOTED_PIECES,
+    TOO_MANY_PIECES,
+    INVALID_CASTLING,
+    INVALID_EN_PASSANT,
+    KINGS_ADJACENT
+};
+
+enum class GameStatus { ONGOING, CHECK_MATE, STALE_MATE, FIFTY_MOVE_RULE };
+
 /**
  * @brief A chess-piece with color and type
  */
@@ -44,4 +63,76 @@ static const int ChessRankIdx = 1;
  */
 using ChessPieceOnField = std::tuple<ChessPiece, ChessField>;
 static const int ChessPieceIdx = 0;
-static const int ChessFieldIdx = 1;
\ No newline at end of file
+static const int ChessFieldIdx = 1;
+
+/**
+ * @brief Compact field of a chess-board in one byte, 0 = a1, 1 = b1, ... 63 = h8
+ *
+ * Internal representation of ChessField. Converts implicitly from and to ChessField, so it can be used
+ * wherever the tuple is expected.
+ */
+class Square {
+   public:
+    constexpr Square(ChessField field)
+        : _index(static_cast<uint8_t>((std::get<ChessRankIdx>(field) - 1) * 8 + std::get<ChessFileIdx>(field) - 1)) {
+        assert(std::get<ChessFileIdx>(field) >= A && std::get<ChessFileIdx>(field) <= H);
+        assert(std::get<ChessRankIdx>(field) >= 1 && std::get<ChessRankIdx>(field) <= 8);
+    }
+    constexpr Square(ChessFile file, ChessRank rank) : Square(ChessField{file, rank}) {}
+
+    static constexpr Square fromIndex(int index) {
+        assert(index >= 0 && index < 64);
+        return Square(static_cast<uint8_t>(index));
+    }
+
+    constexpr int index() const { return _index; }
+    constexpr ChessFile file() const { return (_index & 7) + 1; }
+    constexpr ChessRank rank() const { return (_index >> 3) + 1; }
+
+    constexpr operator ChessField() const { return {file(), rank()}; }
+    constexpr bool operator==(const Square& other) const = default;
+
+   private:
+    constexpr explicit Square(uint8_t index) : _index(index) {}
+
+    uint8_t _index;
+};
+
+/**
+ * @brief Compact chess-piece in one byte, or no piece at all
+ *
+ * Internal representation of ChessPiece and of an empty field. Converts implicitly from ChessPiece and to
+ * ChessPiece, the latter only for codes that hold a piece.
+ */
+class PieceCode {
+   public:
+    constexpr PieceCode() = default;
+    constexpr PieceCode(ChessPiece piece) : _code(encode(std::get<ColorIdx>(piece), std::get<PieceIdx>(piece))) {}
+
+    constexpr bool empty() const { return _code == 0; }
+    constexpr explicit operator bool() const { return _code != 0; }
+
+    constexpr Color color() const {
+        assert(!empty());
+        return static_cast<Color>(_code >> 3);
+    }
+    constexpr Piece piece() const {
+        assert(!empty());
+        return static_cast<Piece>((_code & 7) - 1);
+    }
+
+    constexpr operator ChessPiece() const { return {color(), piece()}; }
+    constexpr std::optional<ChessPiece> toOptional() const {
+        if (empty()) return std::nullopt;
+        return static_cast<ChessPiece>(*this);
+    }
+    constexpr bool operator==(const PieceCode& other) const = default;
+
+   private:
+    // Bit 3 is the color, bits 0-2 the piece + 1, so that 0 stays free for the empty field
+    static constexpr uint8_t encode(Color color, Piece piece) {
+        return static_cast<uint8_t>((static_cast<int>(color) << 3) | (static_cast<int>(piece) + 1));
+    }
+
+    uint8_t _code = 0;
+};
@@ -0,0 +1,286 @@
+#include "uci.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "board_factory.h"
+#include "fen.h"
+#include "fmt/core.h"
+#include "move_debug.h"
+#include "rules.h"
+
+static const std::vector<std::string> Commands = {"uci", "debug", "isready", "setoption", "register", "ucinewgame",
+                                                  "position", "go", "stop", "ponderhit", "quit"};
+
+static constexpr int DefaultHashSize = 16;
+static constexpr int MaxHashSize = 4096;
+static constexpr int MaxThreads = 256;
+static constexpr int MaxMultiPV = 256;
+
+static std::vector<std::string> tokenize(std::string_view line) {
+    std::vector<std::string> tokens;
+    std::istringstream stream{std::string(line)};
+    std::string token;
+    while (stream >> token) tokens.push_back(token);
+    return tokens;
+}
+
+UciEngine::UciEngine(std::istream& in, std::ostream& out)
+    : _in(in), _out(out), _board(BoardFactory::createStandardBoard()), _random(std::random_device{}()) {
+    _search.setHashSize(DefaultHashSize);
+}
+
+void UciEngine::loop() {
+    std::string line;
+    while (std::getline(_in, line)) {
+        if (!handleCommand(line)) return;
+    }
+    // Input is gone, so nobody could ever stop an infinite search. Finite searches may still finish.
+    if (_waitsForStop) _search.stop();
+    _search.wait();
+}
+
+bool UciEngine::handleCommand(std::string_view line) {
+    Tokens tokens = tokenize(line);
+
+    // Unknown tokens in front of a command are ignored as required by the protocol
+    auto cmdIt = std::find_if(tokens.begin(), tokens.end(), [](const std::string& token) {
+        return std::find(Commands.begin(), Commands.end(), token) != Commands.end();
+    });
+    if (cmdIt == tokens.end()) return true;
+    tokens.erase(tokens.begin(), cmdIt);
+    const std::string& cmd = tokens.front();
+
+    if (cmd == "uci") {
+        cmdUci();
+    } else if (cmd == "isready") {
+        send("readyok");
+    } else if (cmd == "setoption") {
+        cmdSetOption(tokens);
+    } else if (cmd == "ucinewgame") {
+        _search.stop();
+        _search.wait();
+        _search.clearHash();
+    } else if (cmd == "position") {
+        cmdPosition(tokens);
+    } else if (cmd == "go") {
+        cmdGo(tokens);
+    } else if (cmd == "stop") {
+        _search.stop();
+    } else if (cmd == "ponderhit") {
+        _waitsForStop = false;
+        _search.ponderhit();
+    } else if (cmd == "quit") {
+        _search.stop();
+        _search.wait();
+        return false;
+    }
+    return true;
+}
+
+const Board& UciEngine::getBoard() const { return _board; }
+
+void UciEngine::cmdUci() {
+    send("id name minusbrain chess");
+    send("id author minusbrain");
+    send(fmt::format("option name Hash type spin default {} min 1 max {}", DefaultHashSize, MaxHashSize));
+    send(fmt::format("option name Threads type spin default 1 min 1 max {}", MaxThreads));
+    send("option name Ponder type check default false");
+    send(fmt::format("option name MultiPV type spin default 1 min 1 max {}", MaxMultiPV));
+    send("option name OwnBook type check default false");
+    send("option name BookFile type string default <empty>");
+    send("uciok");
+}
+
+// setoption name <id> [value <x>] - both id and value may contain spaces
+void UciEngine::cmdSetOption(const Tokens& tokens) {
+    std::string name;
+    std::string value;
+    std::string* current = nullptr;
+    for (size_t i = 1; i < tokens.size(); ++i) {
+        if (tokens[i] == "name") {
+            current = &name;
+        } else if (tokens[i] == "value") {
+            current = &value;
+        } else if (current) {
+            if (!current->empty()) current->append(" ");
+            current->append(tokens[i]);
+        }
+    }
+    std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return std::tolower(c); });
+
+    try {
+        if (name == "hash") {
+            _search.setHashSize(std::clamp(std::stoi(value), 1, MaxHashSize));
+        } else if (name == "threads") {
+            _search.setThreads(std::clamp(std::stoi(value), 1, MaxThreads));
+        } else if (name == "multipv") {
+            _search.setMultiPV(std::clamp(std::stoi(value), 1, MaxMultiPV));
+        } else if (name == "ownbook") {
+            _ownBook = (value == "true");
+        } else if (name == "bookfile") {
+            if (value.empty() || value == "<empty>") {
+                _book.close();
+            } else if (!_book.open(value)) {
+                send(fmt::format("info string could not open book {}", value));
+            }
+        }
+    } catch (const std::exception&) {
+        // Invalid values are ignored
+    }
+}
+
+// position [fen <fenstring> | startpos] moves <move1> .... <movei>
+void UciEngine::cmdPosition(const Tokens& tokens) {
+    auto movesIt = std::find(tokens.begin(), tokens.end(), "moves");
+    Board board;
+
+    if (tokens.size() > 1 && tokens[1] == "startpos") {
+        board = BoardFactory::createStandardBoard();
+    } else if (tokens.size() > 2 && tokens[1] == "fen") {
+        std::string fen;
+        for (auto it = tokens.begin() + 2; it != movesIt; ++it) {
+            if (!fen.empty()) fen.append(" ");
+            fen.append(*it);
+        }
+        FenResult result = Fen::parse(fen, board);
+        if (!result) {
+            send(fmt::format("info string invalid fen: {}", Fen::describe(result.error)));
+            return;
+        }
+        // The search relies on a legal position, e.g. on both kings being present, so keep the previous one
+        IllegalityReason illegality = ChessRules::findIllegalityReason(board);
+        if (illegality != IllegalityReason::NONE) {
+            send(fmt::format("info string illegal position: {}", ChessRules::describe(illegality)));
+            return;
+        }
+    } else {
+        return;
+    }
+
+    // Only a fully valid command replaces the position, so an illegal move does not leave a half applied line behind
+    RepetitionHistory history;
+    if (movesIt != tokens.end()) {
+        for (auto it = movesIt + 1; it != tokens.end(); ++it) {
+            auto move = parseMove(board, *it);
+            if (!move) {
+                send(fmt::format("info string illegal move {}", *it));
+                return;
+            }
+            history.push(board);
+            ChessRules::applyMove(board, *move);
+        }
+    }
+
+    _board = board;
+    _history = std::move(history);
+}
+
+void UciEngine::cmdGo(const Tokens& tokens) {
+    SearchLimits limits;
+    using std::chrono::milliseconds;
+
+    for (size_t i = 1; i < tokens.size(); ++i) {
+        const std::string& token = tokens[i];
+        bool hasValue = i + 1 < tokens.size();
+        try {
+            if (token == "wtime" && hasValue) {
+                limits.whiteTime = milliseconds{std::stoll(tokens[++i])};
+            } else if (token == "btime" && hasValue) {
+                limits.blackTime = milliseconds{std::stoll(tokens[++i])};
+            } else if (token == "winc" && hasValue) {
+                limits.whiteIncrement = milliseconds{std::stoll(tokens[++i])};
+            } else if (token == "binc" && hasValue) {
+                limits.blackIncrement = milliseconds{std::stoll(tokens[++i])};
+            } else if (token == "movestogo" && hasValue) {
+                limits.movesToGo = std::stoi(tokens[++i]);
+            } else if (token == "depth" && hasValue) {
+                limits.depth = std::stoi(tokens[++i]);
+            } else if (token == "nodes" && hasValue) {
+                limits.nodes = std::stoull(tokens[++i]);
+            } else if (token == "mate" && hasValue) {
+                limits.mate = std::stoi(tokens[++i]);
+            } else if (token == "movetime" && hasValue) {
+                limits.moveTime = milliseconds{std::stoll(tokens[++i])};
+            } else if (token == "infinite") {
+                limits.infinite = true;
+            } else if (token == "ponder") {
+                limits.ponder = true;
+            } else if (token == "searchmoves") {
+                while (i + 1 < tokens.size()) {
+                    auto move = parseMove(_board, tokens[i + 1]);
+                    if (!move) break;
+                    limits.searchMoves.push_back(*move);
+                    ++i;
+                }
+            }
+        } catch (const std::exception&) {
+            // Ignore malformed numbers and keep parsing the rest of the line
+        }
+    }
+
+    // Infinite and ponder searches must not answer before being stopped, so they never use the book
+    if (_ownBook && _book.isOpen() && !limits.infinite && !limits.ponder && limits.searchMoves.empty()) {
+        auto bookMove = _book.pickMove(_board, _random());
+        if (bookMove) {
+            // A search still running, e.g. a ponder search nobody stopped, answers first and not after the book move
+            _search.stop();
+            _search.wait();
+            _waitsForStop = false;
+            send(fmt::format("bestmove {}", moveToString(*bookMove)));
+            return;
+        }
+    }
+
+    _waitsForStop = limits.infinite || limits.ponder;
+    _search.setHistory(_history);
+    _search.start(
+        _board, limits, [this](const SearchInfo& info) { sendInfo(info); }, [this](const SearchResult& result) { sendResult(result); });
+}
+
+void UciEngine::sendInfo(const SearchInfo& info) {
+    std::string line = fmt::format("info depth {} multipv {} score ", info.depth, info.multiPv);
+    if (info.mateIn)
+        line += fmt::format("mate {}", *info.mateIn);
+    else
+        line += fmt::format("cp {}", info.score);
+
+    auto ms = info.time.count();
+    line += fmt::format(" nodes {} nps {} time {}", info.nodes, ms > 0 ? info.nodes * 1000 / ms : info.nodes, ms);
+    if (!info.pv.empty()) {
+        line += " pv";
+        for (const Move& move : info.pv) line += " " + moveToString(move);
+    }
+    send(line);
+}
+
+void UciEngine::sendResult(const SearchResult& result) {
+    std::string line = fmt::format("bestmove {}", result.bestMove ? moveToString(*result.bestMove) : "0000");
+    if (result.bestMove && result.ponderMove) line += " ponder " + moveToString(*result.ponderMove);
+    send(line);
+}
+
+void UciEngine::send(const std::string& line) {
+    std::lock_guard<std::mutex> lock(_outMutex);
+    _out << line << std::endl;
+}
+
+std::string UciEngine::moveToString(const Move& move) {
+    std::string str = chessFieldToLAN(move.getStartField()) + chessFieldToLAN(move.getEndField());
+    if (move.hasModifier(MoveModifier::PROMOTE_QUEEN))
+        str += 'q';
+    else if (move.hasModifier(MoveModifier::PROMOTE_ROOK))
+        str += 'r';
+    else if (move.hasModifier(MoveModifier::PROMOTE_BISHOP))
+        str += 'b';
+    else if (move.hasModifier(MoveModifier::PROMOTE_KNIGHT))
+        str += 'n';
+    return str;
+}
+
+std::optional<Move> UciEngine::parseMove(const Board& board, std::string_view str) {
+    for (const Move& move : ChessRules::getAllValidMoves(board, false)) {
+        if (moveToString(move) == str) return move;
+    }
+    return std::nullopt;
+}
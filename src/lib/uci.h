@@ -0,0 +1,76 @@
+#pragma once
+#include <istream>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "base/helpers.h"
+#include "board.h"
+#include "move.h"
+#include "opening_book.h"
+#include "repetition_history.h"
+#include "search.h"
+
+/**
+ * @brief Engine side of the Universal Chess Interface (see docs/engine-interface.txt)
+ *
+ * The thread calling loop() only reads and dispatches commands, the search itself runs on its own
+ * threads. This keeps the engine responsive to "stop", "isready" or "quit" while it is thinking.
+ */
+class UciEngine : base::NONCOPYABLE {
+   public:
+    UciEngine(std::istream& in, std::ostream& out);
+
+    /**
+     * @brief Process commands until "quit" is received or the input ends
+     */
+    void loop();
+
+    /**
+     * @brief Process a single command line
+     *
+     * @return false in case the engine shall quit
+     */
+    bool handleCommand(std::string_view line);
+
+    const Board& getBoard() const;
+
+    /**
+     * @brief Convert a move to UCI long algebraic notation, e.g. e2e4, e1g1 or e7e8q
+     */
+    static std::string moveToString(const Move& move);
+
+    /**
+     * @brief Find the valid move on the board matching a move in UCI long algebraic notation
+     */
+    static std::optional<Move> parseMove(const Board& board, std::string_view str);
+
+   private:
+    using Tokens = std::vector<std::string>;
+
+    void cmdUci();
+    void cmdSetOption(const Tokens& tokens);
+    void cmdPosition(const Tokens& tokens);
+    void cmdGo(const Tokens& tokens);
+
+    void sendInfo(const SearchInfo& info);
+    void sendResult(const SearchResult& result);
+    void send(const std::string& line);
+
+    std::istream& _in;
+    std::ostream& _out;
+    std::mutex _outMutex;
+
+    Board _board;
+    RepetitionHistory _history;  // Positions before _board
+    Search _search;
+    bool _waitsForStop = false;
+
+    PolyglotBook _book;
+    bool _ownBook = false;
+    std::mt19937_64 _random;
+};
@@ -0,0 +1,15 @@
+#include <iostream>
+
+#include "bench.h"
+#include "uci.h"
+
+base::BenchmarkStatistics CHESS_BENCH;
+
+int main() {
+    std::ios::sync_with_stdio(false);
+
+    UciEngine engine{std::cin, std::cout};
+    engine.loop();
+
+    return 0;
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include <cstdint>
+
+#include "types.h"
+
+class Board;
+
+/**
+ * @brief Zobrist hashing of chess-boards
+ *
+ * Every board is reduced to a 64 bit key by XOR-ing one random number per occupied field, per castling
+ * right, for the en-passant file and for the side to move. The random numbers are the published
+ * Polyglot Random64 table and the en-passant file is only hashed if a pawn can actually capture, so the
+ * keys are the ones Polyglot opening books from any tool are indexed with.
+ */
+class Zobrist {
+   public:
+    /**
+     * @brief Calculate the Zobrist key of a board from scratch
+     *
+     * @param board  The board to hash
+     * @return uint64_t Zobrist key
+     */
+    static uint64_t hash(const Board& board);
+
+    static uint64_t pieceKey(ChessPiece piece, ChessField field);
+    static uint64_t castlingKey(int index);
+    static uint64_t enPassantKey(ChessFile file);
+    static uint64_t turnKey();
+};